@@ -154,6 +154,40 @@ bool callstack_emplaceWithAddress(struct callstack* self, const void* address);
 bool callstack_emplaceWithBacktrace(struct callstack * self,
                                     void * trace[], int traceLength);
 
+/**
+ * @brief Constructs the given callstack object in an async-signal-safe way.
+ *
+ * Stores the backtrace of the calling function. This function neither
+ * allocates memory nor takes any locks, it can therefore be used in signal
+ * handlers, including those running on an alternate signal stack.<br>
+ * The function @c backtrace is never used; if it is selected as unwinder, the
+ * frame pointers are walked instead. The callstack is most complete if a
+ * callstack has been created normally in the calling thread before.<br>
+ * The callstack object needs to be destructed using the function
+ * @code callstack_destroy(struct callstack *)@endcode after use, which must
+ * not happen inside of the signal handler once the callstack has been translated.
+ *
+ * @param self A pointer to the callstack object to be constructed.
+ * @return Whether the given callstack object was constructed successfully.
+ * @since v2.4
+ */
+bool callstack_emplaceSignalSafe(struct callstack* self);
+
+/**
+ * @brief Stores the return addresses of the calling function into the given buffer.
+ *
+ * This function is async-signal-safe and does not allocate memory, just like
+ * @code callstack_emplaceSignalSafe(struct callstack *)@endcode.<br>
+ * The stored addresses can later be turned into a callstack object using the
+ * function @code callstack_emplaceWithBacktrace(struct callstack *, void **, int)@endcode.
+ *
+ * @param buffer The buffer to store the return addresses in.
+ * @param bufferSize The count of available elements in the given buffer.
+ * @return The count of stored return addresses.
+ * @since v2.4
+ */
+size_t callstack_captureRaw(void** buffer, size_t bufferSize);
+
 /**
  * @brief Copies the given callstack.
  *
@@ -204,6 +238,88 @@ struct callstack_frame* callstack_translateRelative(struct callstack* self, cons
  */
 struct callstack_frame * callstack_toArray(struct callstack * self);
 
+/**
+ * @brief Translates the given range of frames of the given callstack and returns
+ * an array of all frames.
+ *
+ * The binary files of all frames are deducted, but only the frames in the given
+ * range are translated; the function name of the other frames that have not
+ * been translated yet is @c NULL . Frames translated before are not
+ * translated again. Once all frames are translated, the callstack is
+ * considered translated.<br>
+ * The range is clamped to the frames of the callstack.<br>
+ * Returns @c NULL if an error happens.
+ *
+ * @param self The callstack object.
+ * @param first The index of the first frame to be translated.
+ * @param count The amount of frames to be translated.
+ * @return An array of the callstack frames.
+ * @since v2.4
+ */
+struct callstack_frame* callstack_translateRange(struct callstack* self, size_t first, size_t count);
+
+/**
+ * @brief Translates the frame at the given index of the given callstack and
+ * returns it.
+ *
+ * The other frames are only translated on demand, see
+ * @code callstack_translateRange(struct callstack *, size_t, size_t)@endcode.<br>
+ * Returns @c NULL if an error happens or if the index is out of bounds.
+ *
+ * @param self The callstack object.
+ * @param index The index of the frame.
+ * @return The translated callstack frame.
+ * @since v2.4
+ */
+struct callstack_frame* callstack_getFrame(struct callstack* self, size_t index);
+
+/**
+ * @brief A function visiting a translated callstack frame.
+ *
+ * The strings of the given frame are borrowed and only valid during the call.
+ *
+ * @param index The index of the frame.
+ * @param frame The translated callstack frame.
+ * @param context The context given to the iteration.
+ * @return Whether to continue with the next frame.
+ * @since v2.4
+ */
+typedef bool (*callstack_frameVisitor)(size_t index, const struct callstack_frame* frame, void* context);
+
+/**
+ * @brief Translates the frames of the given callstack one after the other and
+ * passes them to the given visitor.
+ *
+ * Each frame is translated into a reused frame on the stack; no array of
+ * frames is created and the callstack itself is left untouched. Frames already
+ * translated are passed as they are.<br>
+ * Returns @c false if the visitor stopped the iteration or an error happens.
+ *
+ * @param self The callstack object.
+ * @param visitor The function to be called with every frame.
+ * @param context The context passed to the visitor.
+ * @return Whether all frames were visited.
+ * @since v2.4
+ */
+bool callstack_forEachFrame(struct callstack* self, callstack_frameVisitor visitor, void* context);
+
+/**
+ * @brief Translates the given callstacks at once.
+ *
+ * Every distinct address is translated only once, the addresses of each binary
+ * file are resolved in a single pass over its debug information. Callstacks
+ * that have already been translated and @c NULL pointers are skipped.<br>
+ * The translated frames are available using the function
+ * @code callstack_toArray(struct callstack *)@endcode afterwards. The frames
+ * borrow their strings if @c callstack_zeroCopy is set.
+ *
+ * @param callstacks the callstacks to be translated
+ * @param count the count of callstacks
+ * @return whether all given callstacks were translated successfully
+ * @since v2.4
+ */
+bool callstack_translateMany(struct callstack** callstacks, size_t count);
+
 /**
  * @brief Translates the given callstack and returns an array of the translated frames.
  *
@@ -225,10 +341,9 @@ struct callstack_frame * callstack_getBinaries(struct callstack * self);
  * If the given has not been translated before, only the binary file
  * information is deducted.
  *
- * The deducted binary information is located in the cache of the library and
- * becomes invalid after a call to @c callstack_clearCaches() or after the
- * callstack has been translated entirely if @c callstack_autoClearCaches is
- * @c true .
+ * The deducted binary information is borrowed from the cache of the library,
+ * the binary files are kept alive by the given callstack until it is
+ * destroyed.
  * <br><br>
  * Returns @c NULL if an error happens.
  *
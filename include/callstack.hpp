@@ -66,6 +66,19 @@ class callstack {
 #endif
     }
 
+    /**
+     * Passes the given frame to the visitor given as context.
+     *
+     * @param index the index of the frame
+     * @param frame the translated frame
+     * @param context the visitor
+     * @return whether to continue with the next frame
+     */
+    template<typename Visitor>
+    static bool visitFrame(const size_t index, const callstack_frame* frame, void* context) {
+        return (*static_cast<Visitor*>(context))(index, *frame);
+    }
+
 public:
     /**
      * @brief A trivial default constructor.
@@ -212,12 +225,47 @@ public:
         return *this;
     }
 
+    /**
+     * @brief Translates the given range of frames of this callstack object.
+     *
+     * The other frames are only translated on demand.
+     *
+     * @param first the index of the first frame to be translated
+     * @param count the amount of frames to be translated
+     * @return @c this
+     * @throws std::runtime_error if the translation failed
+     * @since v2.4
+     */
+    inline callstack& translateRange(const size_t first, const size_t count) {
+        if (callstack_translateRange(*this, first, count) == LCS_NULL) {
+            throw std::runtime_error("LCS: Failed to translate the callstack range");
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Translates the frames of this callstack one after the other and
+     * passes them to the given visitor.
+     *
+     * The visitor is called with the index and the frame and returns whether
+     * to continue; it must not throw. The strings of the frames are only valid
+     * during the call.
+     *
+     * @param visitor the visitor to be called with every frame
+     * @return whether all frames were visited
+     * @since v2.4
+     */
+    template<typename Visitor>
+    inline bool forEachFrame(Visitor visitor) {
+        return callstack_forEachFrame(*this, &callstack::visitFrame<Visitor>, &visitor);
+    }
+
 #ifdef LCS_USE_UNSAFE_OPTIMIZATION
     /**
      * @brief Translates this callstack object.
      *
-     * Only the names of the runtime images are deducted. They are backed by
-     * the cache of the library and only valid as long as the cache is.
+     * Only the names of the runtime images are deducted. They are borrowed
+     * from the cache of the library, which is kept alive by this callstack.
      *
      * @return @c this
      * @throws std::runtime_error if the translation failed
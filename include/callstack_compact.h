@@ -0,0 +1,193 @@
+/*
+ * CallstackLibrary - Library creating human-readable call stacks.
+ *
+ * Copyright (C) 2026  mhahnFr
+ *
+ * This file is part of the CallstackLibrary.
+ *
+ * The CallstackLibrary is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The CallstackLibrary is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with the
+ * CallstackLibrary, see the file LICENSE.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _lcs_callstack_compact_h
+#define _lcs_callstack_compact_h
+
+#include "callstack.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * The amount of frames stored inside of a compact callstack object without
+ * allocating.
+ *
+ * @since v2.4
+ */
+#define CALLSTACK_COMPACT_INLINE_SIZE 8
+
+/**
+ * @brief A structure representing a callstack whose size depends on the
+ * amount of its frames.
+ *
+ * Up to @c CALLSTACK_COMPACT_INLINE_SIZE frames are stored inside of the
+ * object itself, longer backtraces are allocated with their exact length.
+ *
+ * @since v2.4
+ */
+struct callstack_compact {
+    /** The type (status) of the translation to be human-readable. */
+    enum callstack_type translationStatus;
+
+    /** The amount of translated frames.                           */
+    size_t frameCount;
+    /** An array of translated callstack frames.                   */
+    struct callstack_frame* frames;
+    /** The size of the backtrace.                                 */
+    size_t backtraceSize;
+    /** The backtrace.                                             */
+    union {
+        /** The backtrace if it fits into the object.              */
+        void*  inlined[CALLSTACK_COMPACT_INLINE_SIZE];
+        /** The allocated backtrace if it is longer.               */
+        void** allocated;
+    } backtrace;
+};
+
+/**
+ * The initializing expression for the compact callstack object.
+ *
+ * @since v2.4
+ */
+#define CALLSTACK_COMPACT_INITIALIZER { NONE, 0, NULL, 0, { { 0 } } }
+
+/**
+ * @brief Constructs the given compact callstack object.
+ *
+ * Stores the backtrace of the calling function, consisting of at most
+ * @c CALLSTACK_BACKTRACE_SIZE frames.<br>
+ * The callstack object needs to be destructed using the function
+ * @code callstack_compact_destroy(struct callstack_compact *)@endcode upon
+ * successful construction and use.
+ *
+ * @param self A pointer to the callstack object to be constructed.
+ * @return Whether the given callstack object was constructed successfully.
+ * @since v2.4
+ */
+bool callstack_compact_emplace(struct callstack_compact* self);
+
+/**
+ * @brief Constructs the given compact callstack object.
+ *
+ * Stores the backtrace of the calling function, consisting of at most the
+ * given amount of frames.<br>
+ * The callstack object needs to be destructed using the function
+ * @code callstack_compact_destroy(struct callstack_compact *)@endcode upon
+ * successful construction and use.
+ *
+ * @param self A pointer to the callstack object to be constructed.
+ * @param maxDepth The maximum amount of frames to be stored.
+ * @return Whether the given callstack object was constructed successfully.
+ * @since v2.4
+ */
+bool callstack_compact_emplaceWithDepth(struct callstack_compact* self, size_t maxDepth);
+
+/**
+ * @brief Constructs the given compact callstack object.
+ *
+ * Copies the given backtrace into the given object.<br>
+ * The callstack object needs to be destructed using the function
+ * @code callstack_compact_destroy(struct callstack_compact *)@endcode upon
+ * successful construction and use.
+ *
+ * @param self A pointer to the callstack object to be constructed.
+ * @param trace The backtrace to be copied.
+ * @param traceLength The length of the given trace.
+ * @return Whether the given callstack object was constructed successfully.
+ * @since v2.4
+ */
+bool callstack_compact_emplaceWithBacktrace(struct callstack_compact* self, void* const trace[], size_t traceLength);
+
+/**
+ * @brief Copies the given compact callstack.
+ *
+ * The given callstack is destroyed before the contents of the other one are copied.
+ *
+ * @param self A pointer to the callstack to be replaced.
+ * @param other The callstack object to be copied.
+ * @return Whether the callstack was copied successfully.
+ * @since v2.4
+ */
+bool callstack_compact_copy(struct callstack_compact* self, const struct callstack_compact* other);
+
+/**
+ * @brief Translates the given compact callstack and returns an array of the
+ * translated frames.
+ *
+ * Returns @c NULL if an error happens.
+ *
+ * @param self The callstack object.
+ * @return An array of translated callstack frames.
+ * @since v2.4
+ */
+struct callstack_frame* callstack_compact_toArray(struct callstack_compact* self);
+
+/**
+ * Returns the backtrace stored in the given compact callstack.
+ *
+ * @param self The callstack object.
+ * @return The stored backtrace.
+ * @since v2.4
+ */
+static inline void* const* callstack_compact_getBacktrace(const struct callstack_compact* self) {
+    return self->backtraceSize <= CALLSTACK_COMPACT_INLINE_SIZE ? self->backtrace.inlined
+                                                                : self->backtrace.allocated;
+}
+
+/**
+ * Returns the number of frames stored in the given compact callstack.
+ *
+ * @param self The callstack object.
+ * @return The number of frames in the given callstack.
+ * @since v2.4
+ */
+static inline size_t callstack_compact_getFrameCount(const struct callstack_compact* self) {
+    return self->backtraceSize;
+}
+
+/**
+ * Returns whether the given compact callstack is already translated.
+ *
+ * @param self The callstack object.
+ * @return Whether the callstack is already translated.
+ * @since v2.4
+ */
+static inline bool callstack_compact_isTranslated(const struct callstack_compact* self) {
+    return self->translationStatus != NONE && self->translationStatus != FAILED;
+}
+
+/**
+ * @brief Destroys the given compact callstack object.
+ *
+ * The contents of the given object are invalidated.
+ *
+ * @param self The callstack object.
+ * @since v2.4
+ */
+void callstack_compact_destroy(struct callstack_compact* self);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _lcs_callstack_compact_h */
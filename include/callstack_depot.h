@@ -0,0 +1,81 @@
+/*
+ * CallstackLibrary - Library creating human-readable call stacks.
+ *
+ * Copyright (C) 2026  mhahnFr
+ *
+ * This file is part of the CallstackLibrary.
+ *
+ * The CallstackLibrary is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The CallstackLibrary is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with the
+ * CallstackLibrary, see the file LICENSE.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _lcs_callstack_depot_h
+#define _lcs_callstack_depot_h
+
+#ifdef __cplusplus
+# include <cstddef>
+# include <cstdint>
+#else
+# include <stddef.h>
+# include <stdint.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Interns the given backtrace into the stack depot.
+ *
+ * Equal backtraces are only stored once; the returned identifier stays valid
+ * for the lifetime of the process. The stack depot does neither take locks
+ * nor use @c malloc , it can therefore be used in allocation hooks and signal
+ * handlers.<br>
+ * Returns @c 0 if the backtrace could not be stored.
+ *
+ * @param trace the backtrace to be interned
+ * @param length the length of the given backtrace
+ * @return the identifier of the interned backtrace
+ * @since v2.4
+ */
+uint32_t callstack_intern(void* const trace[], size_t length);
+
+/**
+ * @brief Interns the backtrace of the calling function into the stack depot.
+ *
+ * The backtrace is created in an async-signal-safe way, just like the function
+ * @code callstack_emplaceSignalSafe(struct callstack *)@endcode does.<br>
+ * Returns @c 0 if the backtrace could not be created or stored.
+ *
+ * @return the identifier of the interned backtrace
+ * @since v2.4
+ */
+uint32_t callstack_internBacktrace(void);
+
+/**
+ * @brief Returns the interned backtrace of the given identifier.
+ *
+ * Returns @c NULL if the given identifier is invalid.
+ *
+ * @param id the identifier of the interned backtrace
+ * @param length the length of the backtrace to be filled
+ * @return the interned backtrace
+ * @since v2.4
+ */
+void* const* callstack_getInterned(uint32_t id, size_t* length);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* _lcs_callstack_depot_h */
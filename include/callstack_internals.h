@@ -44,10 +44,63 @@ extern bool callstack_rawNames;
  */
 extern bool callstack_autoClearCaches;
 
+/**
+ * @brief Indicates whether translated callstack frames borrow their strings
+ * from the library instead of copying them.
+ *
+ * The borrowed names are owned by the parsed binary files, which are kept
+ * alive by the callstacks borrowing from them until these are destroyed, even
+ * across calls to @code callstack_clearCaches()@endcode. Copies of single
+ * frames never borrow.
+ *
+ * @since v2.4
+ */
+extern bool callstack_zeroCopy;
+
+/**
+ * @brief Indicates whether only the names of the functions are deducted.
+ *
+ * If set, the ELF binaries are symbolized using the dynamic symbol tables of
+ * their loaded images without reading any files; no source file information
+ * is available then. Images without a backing file, like the vDSO, are always
+ * symbolized that way. Takes effect for binaries parsed afterwards, the
+ * caches should be cleared after changing it.
+ *
+ * @since v2.4
+ */
+extern bool callstack_functionNamesOnly;
+
+/**
+ * The strategies available for unwinding the stack.
+ *
+ * @since v2.4
+ */
+enum callstack_unwinderType {
+    /** Uses the function @c backtrace of the @c libexecinfo.                          */
+    CALLSTACK_UNWINDER_EXECINFO,
+    /** Walks the chain of frame pointers, checking each frame against the stack bounds. */
+    CALLSTACK_UNWINDER_FRAME_POINTER,
+    /** Interprets the DWARF call frame information of the loaded ELF binaries.        */
+    CALLSTACK_UNWINDER_CFI
+};
+
+/**
+ * @brief The strategy used for unwinding the stack.
+ *
+ * If the call frame information cannot be used, the frame pointers are walked.
+ * If the chosen strategy cannot unwind the stack, the function @c backtrace of
+ * the @c libexecinfo is used instead.
+ *
+ * @since v2.4
+ */
+extern enum callstack_unwinderType callstack_unwinder;
+
 /**
  * @brief Clears the caches of this library.
  *
- * Only needs to be called when @c callstack_autoClearCaches is @c false .
+ * Only needs to be called when @c callstack_autoClearCaches is @c false .<br>
+ * Translations running concurrently on other threads are not disturbed: The
+ * caches are released once they are no longer used.
  *
  * @since v1.1
  */
@@ -22,6 +22,8 @@
 #ifndef _lcs_regions_regions_h
 #define _lcs_regions_regions_h
 
+#include <pthread.h>
+
 #ifdef __cplusplus
 # include <cstdint>
 #else
@@ -100,6 +102,28 @@ struct regionInfo regions_getLoadedRegions(void);
  */
 struct regionInfo regions_getTLSRegions(void);
 
+/**
+ * @brief Returns an array containing the thread-local memory region
+ * information structures of all currently loaded runtime images for the given
+ * thread.
+ *
+ * For the calling thread, the same regions as by
+ * @code regions_getTLSRegions()@endcode are returned. For other threads, only
+ * the static thread-local storage is found on Linux, that is the thread-local
+ * storage of the runtime images loaded at startup and of those using the
+ * initial-exec model. On macOS, no regions are found for other threads.<br>
+ * The given thread must not exit while this function is running.<br>
+ * The returned array must be destructed after use with the function
+ * @code regions_destroyInfo(const struct regionInfo* info)@endcode.
+ * <br><br>
+ * According to @c callstack_autoClearCaches cache pointers are used.
+ *
+ * @param thread the thread whose thread-local storage regions to return
+ * @return an array with thread-local storage memory regions
+ * @since v2.4
+ */
+struct regionInfo regions_getTLSRegionsOf(pthread_t thread);
+
 /**
  * Destructs the given region information.
  *
@@ -20,12 +20,22 @@
  */
 
 #include <dlfcn.h>
+#include <inttypes.h>
+#include <limits.h>
 #include <stdlib.h>
+#include <string.h>
 #include <misc/string_utils.h>
 
 #include "callstackInternal.h"
 #include "lcs_builtins.h"
+#include "callstackFrame/callstackFrameArena.h"
+#include "callstackFrame/callstackFrameInternal.h"
 #include "dlMapper/dlMapper.h"
+#include "dlMapper/dlMapper_platform.h"
+#include "parser/callstack_parser.h"
+
+/** The size of the buffer the strings of a visited frame are formatted into. */
+#define CALLSTACK_SCRATCH_SIZE 1024
 
 struct callstack* callstack_new(void) {
     return callstack_newWithAddress(lcs_returnAddress(0));
@@ -61,6 +71,29 @@ bool callstack_emplaceWithBacktrace(struct callstack * self,
     return true;
 }
 
+bool callstack_emplaceSignalSafe(struct callstack* self) {
+    void* trace[CALLSTACK_BACKTRACE_SIZE];
+    const int size = callstack_backtraceSignalSafe(trace, CALLSTACK_BACKTRACE_SIZE, lcs_returnAddress(0));
+    return callstack_emplaceWithBacktrace(self, trace, size);
+}
+
+size_t callstack_captureRaw(void** buffer, const size_t bufferSize) {
+    if (bufferSize >= CALLSTACK_BACKTRACE_SIZE) {
+        const int size = callstack_backtraceSignalSafe(buffer, bufferSize > INT_MAX ? INT_MAX : (int) bufferSize,
+                                                       lcs_returnAddress(0));
+        return size < 0 ? 0 : (size_t) size;
+    }
+
+    // The frames of the library need to fit into the buffer in order to be removed.
+    void* trace[CALLSTACK_BACKTRACE_SIZE];
+    const int size = callstack_backtraceSignalSafe(trace, CALLSTACK_BACKTRACE_SIZE, lcs_returnAddress(0));
+    if (size < 0) return 0;
+
+    const size_t count = (size_t) size < bufferSize ? (size_t) size : bufferSize;
+    memcpy(buffer, trace, count * sizeof(void*));
+    return count;
+}
+
 void callstack_copy(struct callstack * self, const struct callstack * other) {
     if (other != self) {
         callstack_destroy(self);
@@ -72,12 +105,13 @@ void callstack_copy(struct callstack * self, const struct callstack * other) {
             self->backtrace[i]   = other->backtrace[i];
         }
         
-        self->frameCount = other->frameCount;
-        if (self->frameCount != 0) {
-            self->frames = malloc(self->frameCount * sizeof(struct callstack_frame));
-            for (size_t i = 0; i < self->frameCount; ++i) {
-                callstack_frame_copyHere(&self->frames[i], &other->frames[i]);
+        if (other->frameCount != 0) {
+            self->frames = callstack_copyFrames(other->frames, other->frameCount);
+            if (self->frames == NULL) {
+                self->translationStatus = NONE;
+                return;
             }
+            self->frameCount = other->frameCount;
         }
     }
 }
@@ -85,15 +119,17 @@ void callstack_copy(struct callstack * self, const struct callstack * other) {
 bool callstack_relativize(struct callstack* self, const char** binaryNames) {
     if (self == NULL) return false;
 
-    dlMapper_init();
+    dlMapper_readLock();
     for (size_t i = 0; i < self->backtraceSize; ++i) {
         const pair_relativeFile_t info = dlMapper_relativize(self->backtrace[i]);
         if (info.first == NULL) {
+            dlMapper_readUnlock();
             return false;
         }
         self->backtrace[i] = (void*) info.second;
         binaryNames[i] = info.first->fileName.absolute;
     }
+    dlMapper_readUnlock();
     return true;
 }
 
@@ -105,10 +141,11 @@ struct callstack_frame* callstack_translateRelative(struct callstack* self, cons
     for (size_t i = 0; i < self->backtraceSize; ++i) {
         vector_push_back(&handles, dlopen(binaryNames[i], RTLD_NOW));
     }
-    dlMapper_init();
+    dlMapper_readLock();
     for (size_t i = 0; i < self->backtraceSize; ++i) {
         self->backtrace[i] = dlMapper_absolutize(self->backtrace[i], binaryNames[i]);
     }
+    dlMapper_readUnlock();
     self->frames = callstack_toArray(self);
     vector_iterate(&handles, if (*element != NULL) {
         dlclose((void*) *element);
@@ -125,6 +162,282 @@ struct callstack_frame * callstack_toArray(struct callstack * self) {
     return self->frames;
 }
 
+/**
+ * Returns whether all frames of the given callstack have been translated.
+ *
+ * @param self the callstack object
+ * @return whether no frame is left to be translated
+ */
+static inline bool callstack_framesTranslated(const struct callstack* self) {
+    for (size_t i = 0; i < self->frameCount; ++i) {
+        if (self->frames[i].function == NULL && self->frames[i].reserved != NULL) {
+            return false;
+        }
+    }
+    return true;
+}
+
+struct callstack_frame* callstack_translateRange(struct callstack* self, const size_t first, size_t count) {
+    if (self == NULL) return NULL;
+    if (self->translationStatus != NONE) return self->frames;
+
+    if (first >= self->backtraceSize) {
+        count = 0;
+    } else if (count > self->backtraceSize - first) {
+        count = self->backtraceSize - first;
+    }
+
+    dlMapper_readLock();
+    if (self->frames != NULL) {
+        callstack_refreshBinariesOf(self->backtrace + first, self->frames + first, count);
+    } else if (callstack_translateBinaries(self, callstack_zeroCopy) == FAILED) {
+        dlMapper_readUnlock();
+        return NULL;
+    }
+    callstack_translateFrames(self->backtrace, self->frames, first, count);
+    if (callstack_framesTranslated(self)) {
+        self->translationStatus = TRANSLATED;
+    }
+    dlMapper_readUnlock();
+    return self->frames;
+}
+
+struct callstack_frame* callstack_getFrame(struct callstack* self, const size_t index) {
+    if (self == NULL || index >= self->backtraceSize) return NULL;
+
+    struct callstack_frame* frames = callstack_translateRange(self, index, 1);
+    return frames == NULL ? NULL : &frames[index];
+}
+
+bool callstack_forEachFrame(struct callstack* self, const callstack_frameVisitor visitor, void* context) {
+    if (self == NULL || visitor == NULL) return false;
+
+    char buffer[CALLSTACK_SCRATCH_SIZE];
+    struct callstackFrameArena arena;
+    // The strings are borrowed or formatted into the buffer, the binary files stay pinned by the parser.
+    callstackFrameArena_create(&arena, buffer, sizeof(buffer), true);
+    struct callstackFrameArena* previous = callstackFrameArena_enter(&arena);
+    struct callstack_parser parser;
+    callstack_parser_create(&parser);
+
+    bool toReturn = true;
+    for (size_t i = 0; toReturn && i < self->backtraceSize; ++i) {
+        if (self->frames != NULL && self->frames[i].function != NULL) {
+            toReturn = visitor(i, &self->frames[i], context);
+            continue;
+        }
+        struct callstack_frame frame;
+        callstackFrame_translateBinary(&frame, self->backtrace[i], true, false);
+        callstack_parser_parseFrames(&parser, self->backtrace + i, &frame, 1);
+        toReturn = visitor(i, &frame, context);
+
+        callstackFrameArena_destroy(&arena);
+        callstackFrameArena_create(&arena, buffer, sizeof(buffer), true);
+    }
+
+    callstack_parser_destroy(&parser);
+    callstackFrameArena_leave(previous);
+    callstackFrameArena_destroy(&arena);
+    return toReturn;
+}
+
+/**
+ * Represents an occurrence of an address in a batch of callstacks.
+ */
+struct callstack_occurrence {
+    /** The address.                                      */
+    void* address;
+    /** The callstack frame the address is translated to. */
+    struct callstack_frame* frame;
+    /** The index of the callstack in the batch.          */
+    size_t callstack;
+};
+
+typedef_vector_named(occurrence, struct callstack_occurrence);
+
+/**
+ * Compares the two given occurrences by their address.
+ *
+ * @param lhs the left-hand side occurrence
+ * @param rhs the right-hand side occurrence
+ * @return a negative number if the first address is smaller, a positive one if
+ * the second address is smaller, zero if equal
+ */
+static inline int callstack_occurrenceCompare(const struct callstack_occurrence* lhs,
+                                              const struct callstack_occurrence* rhs) {
+    if (lhs->address < rhs->address) return -1;
+    if (lhs->address > rhs->address) return +1;
+    return 0;
+}
+
+/**
+ * @brief Collects the addresses of the given callstacks that need to be translated.
+ *
+ * The frame arrays of these callstacks are allocated.
+ *
+ * @param callstacks the callstacks
+ * @param count the count of callstacks
+ * @param occurrences the vector to be filled with the occurrences of the addresses
+ * @return whether all callstacks could be prepared
+ */
+static inline bool callstack_collectOccurrences(struct callstack** callstacks, const size_t count,
+                                                vector_occurrence_t* occurrences) {
+    bool success = true;
+    for (size_t i = 0; i < count; ++i) {
+        struct callstack* callstack = callstacks[i];
+        if (callstack == NULL || callstack->translationStatus != NONE) continue;
+
+        callstack_reset(callstack);
+        callstack->frames = callstackFrameArena_newFrames(callstack->backtraceSize);
+        if (callstack->frames == NULL) {
+            success = false;
+            continue;
+        }
+        callstack->frameCount = callstack->backtraceSize;
+        for (size_t j = 0; j < callstack->backtraceSize; ++j) {
+            callstack->frames[j] = callstack_frame_initializer;
+            if (!vector_push_back(occurrences, ((struct callstack_occurrence) {
+                callstack->backtrace[j], &callstack->frames[j], i
+            }))) {
+                success = false;
+            }
+        }
+    }
+    return success;
+}
+
+/**
+ * @brief Translates the given unique addresses.
+ *
+ * The addresses are grouped by their binary file, each group is translated at once.
+ *
+ * @param addresses the unique addresses, sorted ascendingly
+ * @param frames the callstack frames to be filled
+ * @param count the count of addresses
+ * @param useCache whether the frames may borrow the strings of the binary files
+ */
+static inline void callstack_translateUnique(void* const addresses[], struct callstack_frame frames[],
+                                             const size_t count, const bool useCache) {
+    for (size_t i = 0; i < count; ++i) {
+        callstackFrame_translateBinary(&frames[i], addresses[i], useCache, false);
+    }
+    for (size_t start = 0, end; start < count; start = end) {
+        struct binaryFile* file = frames[start].reserved;
+        for (end = start + 1; end < count && frames[end].reserved == file; ++end);
+
+        if (file != NULL) {
+            binaryFile_addr2StringSorted(file, addresses + start, frames + start, end - start);
+        }
+    }
+}
+
+/**
+ * @brief Marks the given callstacks prepared for the translation as translated.
+ *
+ * Callstacks all of whose frames failed to be translated are marked as failed.
+ *
+ * @param callstacks the callstacks
+ * @param count the count of callstacks
+ * @param failures the counts of the failed frames of the callstacks, @c NULL if none failed
+ * @return whether no callstack failed
+ */
+static inline bool callstack_finishMany(struct callstack** callstacks, const size_t count, const size_t* failures) {
+    bool success = true;
+    for (size_t i = 0; i < count; ++i) {
+        struct callstack* callstack = callstacks[i];
+        if (callstack == NULL || callstack->translationStatus != NONE || callstack->frames == NULL) continue;
+
+        if ((failures == NULL ? 0 : failures[i]) == callstack->backtraceSize) {
+            callstack_reset(callstack);
+            callstack->translationStatus = FAILED;
+            success = false;
+        } else {
+            callstack->translationStatus = TRANSLATED;
+        }
+    }
+    return success;
+}
+
+bool callstack_translateMany(struct callstack** callstacks, const size_t count) {
+    if (callstacks == NULL) return false;
+
+    vector_occurrence_t occurrences = vector_initializer;
+    bool success = callstack_collectOccurrences(callstacks, count, &occurrences);
+    if (occurrences.count == 0) {
+        // Only empty callstacks, if any, have been prepared.
+        vector_destroy(&occurrences);
+        return callstack_finishMany(callstacks, count, NULL) && success;
+    }
+    vector_sort(&occurrences, callstack_occurrenceCompare);
+
+    void** addresses = malloc(occurrences.count * sizeof(void*));
+    struct callstack_frame* frames = callstackFrameArena_newFrames(occurrences.count);
+    size_t* failures = calloc(count, sizeof(size_t));
+    if (addresses == NULL || frames == NULL || failures == NULL) {
+        free(addresses);
+        callstackFrameArena_deleteFrames(frames);
+        free(failures);
+        vector_destroy(&occurrences);
+        for (size_t i = 0; i < count; ++i) {
+            if (callstacks[i] != NULL && callstacks[i]->translationStatus == NONE) callstack_reset(callstacks[i]);
+        }
+        return false;
+    }
+
+    size_t unique = 0;
+    vector_iterate(&occurrences, {
+        if (unique == 0 || addresses[unique - 1] != element->address) {
+            addresses[unique++] = element->address;
+        }
+    });
+
+    struct callstack_parser parser;
+    callstack_parser_create(&parser);
+    struct callstackFrameArena* previous = callstackFrameArena_enter(callstackFrameArena_of(frames));
+    callstack_translateUnique(addresses, frames, unique, callstack_zeroCopy);
+
+    size_t current = 0;
+    bool first = true, failed = false;
+    vector_iterate(&occurrences, {
+        if (addresses[current] != element->address) {
+            ++current;
+            first = true;
+        }
+        struct callstack_frame* frame = &frames[current];
+        if (first) {
+            failed = frame->reserved != NULL && frame->function == NULL;
+            if (failed) {
+                frame->reserved2 = false;
+                callstackFrameArena_enter(callstackFrameArena_of(frames));
+                frame->function = callstackFrameArena_format("0x%" PRIxPTR,
+                                                             dlMapper_platform_relativize(frame->reserved,
+                                                                                          element->address));
+            }
+            first = false;
+        }
+        // The translated frame is copied into the arena of each callstack it occurs in, which keeps the
+        // binary file of borrowed strings alive once the frames of the batch are deleted.
+        callstackFrameArena_enter(callstackFrameArena_of(callstacks[element->callstack]->frames));
+        if ((frame->reserved1 || frame->reserved2) && !callstackFrameArena_retain(frame->reserved)) {
+            frame->reserved1 = false;
+            frame->reserved2 = false;
+        }
+        callstack_frame_copyHere(element->frame, frame);
+        if (failed) {
+            ++failures[element->callstack];
+        }
+    });
+    callstackFrameArena_leave(previous);
+    callstack_parser_destroy(&parser);
+
+    success = callstack_finishMany(callstacks, count, failures) && success;
+    free(failures);
+    callstackFrameArena_deleteFrames(frames);
+    free(addresses);
+    vector_destroy(&occurrences);
+    return success;
+}
+
 /**
  * Retrieves the binary file information for the given callstack object.
  *
@@ -135,7 +448,7 @@ struct callstack_frame * callstack_toArray(struct callstack * self) {
 static inline struct callstack_frame* callstack_getBinariesShared(struct callstack* self, const bool useCache) {
     if (self == NULL) return NULL;
 
-    if ((self->translationStatus == NONE || self->translationStatus == FAILED)
+    if ((self->translationStatus == NONE || self->translationStatus == FAILED) && self->frames == NULL
         && callstack_translateBinaries(self, useCache) == FAILED) {
         return NULL;
     }
@@ -153,15 +466,8 @@ struct callstack_frame* callstack_getBinariesCached(struct callstack* self) {
 void callstack_destroy(struct callstack * self) {
     self->translationStatus = NONE;
     self->backtraceSize     = 0;
-    
-    if (self->frames != NULL) {
-        for (size_t i = 0; i < self->frameCount; ++i) {
-            callstack_frame_destroy(&self->frames[i]);
-        }
-        free(self->frames);
-    }
-    
-    self->frameCount = 0;
+
+    callstack_reset(self);
 }
 
 void callstack_delete(struct callstack * self) {
@@ -0,0 +1,217 @@
+/*
+ * CallstackLibrary - Library creating human-readable call stacks.
+ *
+ * Copyright (C) 2026  mhahnFr
+ *
+ * This file is part of the CallstackLibrary.
+ *
+ * The CallstackLibrary is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The CallstackLibrary is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with the
+ * CallstackLibrary, see the file LICENSE.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "callstackFrameArena.h"
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../parser/lcs_stdio.h"
+#include "../parser/file/binaryFile.h"
+
+/** The amount of bytes reserved for the strings of each frame in the first block. */
+#define CALLSTACK_FRAME_ARENA_PER_FRAME  128
+/** The minimal size of an additionally allocated chunk.                           */
+#define CALLSTACK_FRAME_ARENA_CHUNK_SIZE 4096
+
+/** The arena the strings of callstack frames are allocated in by the calling thread. */
+static _Thread_local struct callstackFrameArena* callstackFrameArena_current = NULL;
+
+struct callstack_frame* callstackFrameArena_newFrames(const size_t count) {
+    if (count > (SIZE_MAX - sizeof(struct callstackFrameArena))
+                / (sizeof(struct callstack_frame) + CALLSTACK_FRAME_ARENA_PER_FRAME)) {
+        return NULL;
+    }
+
+    struct callstackFrameArena* self = malloc(sizeof(struct callstackFrameArena)
+                                              + count * (sizeof(struct callstack_frame) + CALLSTACK_FRAME_ARENA_PER_FRAME));
+    if (self == NULL) {
+        return NULL;
+    }
+    struct callstack_frame* frames = (struct callstack_frame*) (self + 1);
+    callstackFrameArena_create(self, (char*) (frames + count), count * CALLSTACK_FRAME_ARENA_PER_FRAME, false);
+    return frames;
+}
+
+void callstackFrameArena_deleteFrames(struct callstack_frame* frames) {
+    if (frames == NULL) return;
+
+    struct callstackFrameArena* self = callstackFrameArena_of(frames);
+    callstackFrameArena_destroy(self);
+    free(self);
+}
+
+void callstackFrameArena_create(struct callstackFrameArena* self, char* memory, const size_t size, const bool pinned) {
+    *self = (struct callstackFrameArena) {
+        .cursor = memory,
+        .end    = memory + size,
+        .pinned = pinned,
+    };
+}
+
+void callstackFrameArena_destroy(struct callstackFrameArena* self) {
+    for (struct callstackFrameArena_reference* it = self->references; it != NULL; it = it->next) {
+        binaryFile_release(it->file);
+    }
+    for (struct callstackFrameArena_chunk* it = self->chunks; it != NULL;) {
+        struct callstackFrameArena_chunk* next = it->next;
+        free(it);
+        it = next;
+    }
+}
+
+struct callstackFrameArena* callstackFrameArena_enter(struct callstackFrameArena* self) {
+    struct callstackFrameArena* previous = callstackFrameArena_current;
+    callstackFrameArena_current = self;
+    return previous;
+}
+
+void callstackFrameArena_leave(struct callstackFrameArena* previous) {
+    callstackFrameArena_current = previous;
+}
+
+/**
+ * @brief Allocates the given amount of bytes in the given arena.
+ *
+ * If the current block of memory is exhausted, a new chunk is allocated.
+ *
+ * @param self the arena
+ * @param size the amount of bytes
+ * @return the allocated memory or @c NULL if the allocation failed
+ */
+static inline char* callstackFrameArena_allocate(struct callstackFrameArena* self, const size_t size) {
+    if ((size_t) (self->end - self->cursor) < size) {
+        const size_t chunkSize = size > CALLSTACK_FRAME_ARENA_CHUNK_SIZE ? size : CALLSTACK_FRAME_ARENA_CHUNK_SIZE;
+        struct callstackFrameArena_chunk* chunk = malloc(sizeof(struct callstackFrameArena_chunk) + chunkSize);
+        if (chunk == NULL) {
+            return NULL;
+        }
+        chunk->next  = self->chunks;
+        self->chunks = chunk;
+        self->cursor = chunk->memory;
+        self->end    = chunk->memory + chunkSize;
+    }
+    char* toReturn = self->cursor;
+    self->cursor += size;
+    return toReturn;
+}
+
+bool callstackFrameArena_isEntered(void) {
+    return callstackFrameArena_current != NULL;
+}
+
+bool callstackFrameArena_retain(struct binaryFile* file) {
+    struct callstackFrameArena* self = callstackFrameArena_current;
+    if (self == NULL) {
+        return false;
+    } else if (self->pinned) {
+        return true;
+    }
+    for (const struct callstackFrameArena_reference* it = self->references; it != NULL; it = it->next) {
+        if (it->file == file) {
+            return true;
+        }
+    }
+
+    // The references are allocated in the arena itself, aligned for pointers.
+    const size_t misalignment = (uintptr_t) self->cursor % _Alignof(struct callstackFrameArena_reference);
+    if (misalignment != 0 && (size_t) (self->end - self->cursor) >= _Alignof(struct callstackFrameArena_reference)) {
+        self->cursor += _Alignof(struct callstackFrameArena_reference) - misalignment;
+    }
+    struct callstackFrameArena_reference* reference
+        = (struct callstackFrameArena_reference*) callstackFrameArena_allocate(self, sizeof(struct callstackFrameArena_reference));
+    if (reference == NULL) {
+        return false;
+    }
+    *reference = (struct callstackFrameArena_reference) { self->references, binaryFile_retain(file) };
+    self->references = reference;
+    return true;
+}
+
+bool callstackFrameArena_retainAll(const struct callstackFrameArena* other) {
+    for (const struct callstackFrameArena_reference* it = other->references; it != NULL; it = it->next) {
+        if (!callstackFrameArena_retain(it->file)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+char* callstackFrameArena_copy(const char* string) {
+    struct callstackFrameArena* self = callstackFrameArena_current;
+    if (string == NULL) {
+        return NULL;
+    } else if (self == NULL) {
+        return strdup(string);
+    }
+
+    // The binary file and the source file names repeat in consecutive frames.
+    for (size_t i = 0; i < CALLSTACK_FRAME_ARENA_RECENT; ++i) {
+        if (self->sources[i] == string && strcmp(self->copies[i], string) == 0) {
+            return self->copies[i];
+        }
+    }
+
+    const size_t size = strlen(string) + 1;
+    char* toReturn = callstackFrameArena_allocate(self, size);
+    if (toReturn == NULL) {
+        return NULL;
+    }
+    memcpy(toReturn, string, size);
+    self->sources[self->recent] = string;
+    self->copies[self->recent]  = toReturn;
+    self->recent = (self->recent + 1) % CALLSTACK_FRAME_ARENA_RECENT;
+    return toReturn;
+}
+
+char* callstackFrameArena_format(const char* format, ...) {
+    struct callstackFrameArena* self = callstackFrameArena_current;
+
+    va_list args;
+    va_start(args, format);
+    if (self == NULL) {
+        char* toReturn;
+        const int result = vasprintf(&toReturn, format, args);
+        va_end(args);
+        return result < 0 ? NULL : toReturn;
+    }
+
+    va_list copy;
+    va_copy(copy, args);
+    const size_t available = (size_t) (self->end - self->cursor);
+    const int length = vsnprintf(self->cursor, available, format, args);
+    va_end(args);
+
+    char* toReturn = NULL;
+    if (length >= 0 && (size_t) length < available) {
+        toReturn = self->cursor;
+        self->cursor += length + 1;
+    } else if (length >= 0) {
+        toReturn = callstackFrameArena_allocate(self, (size_t) length + 1);
+        if (toReturn != NULL) {
+            vsnprintf(toReturn, (size_t) length + 1, format, copy);
+        }
+    }
+    va_end(copy);
+    return toReturn;
+}
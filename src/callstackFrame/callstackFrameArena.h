@@ -0,0 +1,237 @@
+/*
+ * CallstackLibrary - Library creating human-readable call stacks.
+ *
+ * Copyright (C) 2026  mhahnFr
+ *
+ * This file is part of the CallstackLibrary.
+ *
+ * The CallstackLibrary is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The CallstackLibrary is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with the
+ * CallstackLibrary, see the file LICENSE.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CALLSTACKLIBRARY_CALLSTACKFRAMEARENA_H
+#define CALLSTACKLIBRARY_CALLSTACKFRAMEARENA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <callstack_frame.h>
+
+/** The count of recently copied strings remembered by an arena. */
+#define CALLSTACK_FRAME_ARENA_RECENT 4
+
+struct binaryFile;
+
+/**
+ * An additional block of memory of a string arena.
+ */
+struct callstackFrameArena_chunk {
+    /** The previously allocated chunk. */
+    struct callstackFrameArena_chunk* next;
+    /** The memory of this chunk.       */
+    char memory[];
+};
+
+/**
+ * A binary file kept alive by an arena, since strings of it are borrowed.
+ */
+struct callstackFrameArena_reference {
+    /** The previously referenced binary file. */
+    struct callstackFrameArena_reference* next;
+    /** The referenced binary file.            */
+    struct binaryFile* file;
+};
+
+/**
+ * @brief The arena the strings of an array of callstack frames are allocated in.
+ *
+ * The arena is stored in front of the callstack frames it belongs to, its
+ * first block of memory directly behind them.
+ */
+struct callstackFrameArena {
+    /** The next free byte.                                   */
+    char* cursor;
+    /** The end of the current block of memory.               */
+    char* end;
+    /** The additionally allocated chunks.                    */
+    struct callstackFrameArena_chunk* chunks;
+    /** The binary files whose strings are borrowed.          */
+    struct callstackFrameArena_reference* references;
+    /** Whether the binary files are kept alive by the user.  */
+    bool pinned;
+    /** The index of the next recently copied string slot.    */
+    size_t recent;
+    /** The original strings that have been copied recently.  */
+    const char* sources[CALLSTACK_FRAME_ARENA_RECENT];
+    /** The copies of the recently copied strings.            */
+    char* copies[CALLSTACK_FRAME_ARENA_RECENT];
+};
+
+/**
+ * @brief Allocates an uninitialized array of callstack frames together with
+ * the arena for their strings.
+ *
+ * The frames need to be deleted using
+ * @code callstackFrameArena_deleteFrames(struct callstack_frame*)@endcode.
+ *
+ * @param count the count of frames
+ * @return the allocated frames or @c NULL if the allocation failed
+ */
+struct callstack_frame* callstackFrameArena_newFrames(size_t count);
+
+/**
+ * @brief Deletes the given array of callstack frames together with all of
+ * their strings.
+ *
+ * The binary files whose strings were borrowed by the frames are released.
+ *
+ * @param frames the frames allocated by
+ * @code callstackFrameArena_newFrames(size_t)@endcode, may be @c NULL
+ */
+void callstackFrameArena_deleteFrames(struct callstack_frame* frames);
+
+/**
+ * @brief Constructs the given arena using the given block of memory.
+ *
+ * The arena needs to be destructed using
+ * @code callstackFrameArena_destroy(struct callstackFrameArena*)@endcode.
+ *
+ * @param self the arena to be constructed
+ * @param memory the first block of memory to allocate in
+ * @param size the size of the given block of memory
+ * @param pinned whether the binary files are kept alive by the user of the
+ * arena, they are not retained by it then
+ */
+void callstackFrameArena_create(struct callstackFrameArena* self, char* memory, size_t size, bool pinned);
+
+/**
+ * @brief Destroys the given arena.
+ *
+ * The additionally allocated chunks are deallocated and the retained binary
+ * files are released.
+ *
+ * @param self the arena to be destroyed
+ */
+void callstackFrameArena_destroy(struct callstackFrameArena* self);
+
+/**
+ * Returns the arena of the given array of callstack frames.
+ *
+ * @param frames the frames allocated by
+ * @code callstackFrameArena_newFrames(size_t)@endcode
+ * @return the arena of the given frames
+ */
+static inline struct callstackFrameArena* callstackFrameArena_of(struct callstack_frame* frames) {
+    return (struct callstackFrameArena*) ((char*) frames - sizeof(struct callstackFrameArena));
+}
+
+/**
+ * @brief Makes the given arena the one the strings of callstack frames are
+ * allocated in by the calling thread.
+ *
+ * Needs to be paired with a call to
+ * @code callstackFrameArena_leave(struct callstackFrameArena*)@endcode.
+ *
+ * @param self the arena, may be @c NULL to allocate on the heap
+ * @return the previously entered arena
+ */
+struct callstackFrameArena* callstackFrameArena_enter(struct callstackFrameArena* self);
+
+/**
+ * Restores the previously entered arena of the calling thread.
+ *
+ * @param previous the arena returned by the paired call to
+ * @code callstackFrameArena_enter(struct callstackFrameArena*)@endcode
+ */
+void callstackFrameArena_leave(struct callstackFrameArena* previous);
+
+/**
+ * Returns whether an arena is entered by the calling thread.
+ *
+ * @return whether the strings of callstack frames are allocated in an arena
+ */
+bool callstackFrameArena_isEntered(void);
+
+/**
+ * @brief Makes the entered arena keep the given binary file alive.
+ *
+ * The reference is released when the frames of the arena are deleted.
+ *
+ * @param file the binary file whose strings are to be borrowed
+ * @return whether the binary file is kept alive by the arena or by its user;
+ * @c false if no arena is entered or the allocation failed
+ */
+bool callstackFrameArena_retain(struct binaryFile* file);
+
+/**
+ * @brief Makes the entered arena keep the binary files of the given arena
+ * alive, too.
+ *
+ * Used when the frames of the given arena are copied into the entered one.
+ *
+ * @param other the arena whose binary files to be retained
+ * @return whether all binary files are kept alive by the entered arena
+ */
+bool callstackFrameArena_retainAll(const struct callstackFrameArena* other);
+
+/**
+ * @brief Returns whether strings of the given binary file may be borrowed by
+ * callstack frames instead of being copied.
+ *
+ * Inside of an arena, the binary file is kept alive by it. Outside of an
+ * arena, the borrowed strings are only valid as long as the caches are.
+ *
+ * @param file the binary file whose strings are to be borrowed
+ * @param requested whether borrowing is requested
+ * @return whether the strings may be borrowed
+ */
+static inline bool callstackFrameArena_borrow(struct binaryFile* file, const bool requested) {
+    return requested && (!callstackFrameArena_isEntered() || callstackFrameArena_retain(file));
+}
+
+/**
+ * @brief Copies the given string for a callstack frame.
+ *
+ * The copy is allocated in the entered arena of the calling thread, on the
+ * heap if none is entered.
+ *
+ * @param string the string to be copied, may be @c NULL
+ * @return the copy or @c NULL if the given string was @c NULL or the allocation failed
+ */
+char* callstackFrameArena_copy(const char* string);
+
+/**
+ * Copies the given string for a callstack frame if requested.
+ *
+ * @param string the string to maybe copy
+ * @param copy whether to copy the string
+ * @return the copy or the original string if @c copy is @c false
+ * @see callstackFrameArena_copy(const char*)
+ */
+static inline char* callstackFrameArena_maybeCopy(const char* string, const bool copy) {
+    return copy ? callstackFrameArena_copy(string) : (char*) string;
+}
+
+/**
+ * @brief Formats a string for a callstack frame.
+ *
+ * The string is allocated in the entered arena of the calling thread, on the
+ * heap if none is entered.
+ *
+ * @param format the format string
+ * @param ... the arguments of the format string
+ * @return the formatted string or @c NULL if the allocation failed
+ */
+char* callstackFrameArena_format(const char* format, ...) __attribute__((format(printf, 1, 2)));
+
+#endif //CALLSTACKLIBRARY_CALLSTACKFRAMEARENA_H
@@ -20,6 +20,7 @@
  */
 
 #include "callstackFrameInternal.h"
+#include "callstackFrameArena.h"
 
 #include "../dlMapper/dlMapper.h"
 
@@ -28,11 +29,12 @@ void callstackFrame_translateBinary(struct callstack_frame* self, const void* ad
     *self = callstack_frame_initializer;
 
     struct binaryFile* info = dlMapper_binaryFileForAddress(address, includeRegions);
+    const bool borrow = info == NULL ? useCache : callstackFrameArena_borrow(info, useCache);
     if (info != NULL) {
-        self->binaryFile = useCache ? info->fileName.absolute : strdup(info->fileName.absolute);
-        self->binaryFileRelative = useCache ? info->fileName.relative : strdup(info->fileName.relative);
+        self->binaryFile = callstackFrameArena_maybeCopy(info->fileName.absolute, !borrow);
+        self->binaryFileRelative = callstackFrameArena_maybeCopy(info->fileName.relative, !borrow);
         self->binaryFileIsSelf = info->isSelf;
     }
     self->reserved = info;
-    self->reserved1 = useCache;
+    self->reserved1 = borrow;
 }
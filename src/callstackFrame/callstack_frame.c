@@ -19,8 +19,12 @@
  * CallstackLibrary, see the file LICENSE.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <stdlib.h>
+#include <string.h>
+
 #include <callstack_frame.h>
-#include <misc/string_utils.h>
+
+#include "callstackFrameArena.h"
 
 struct callstack_frame* callstack_frame_new() {
     struct callstack_frame* toReturn = malloc(sizeof(struct callstack_frame));
@@ -41,17 +45,21 @@ struct callstack_frame* callstack_frame_copy(const struct callstack_frame* self)
 }
 
 void callstack_frame_copyHere(struct callstack_frame * destination, const struct callstack_frame * source) {
+    // Borrowed strings are only shared if the binary files are kept alive by the entered arena.
+    const bool share   = callstackFrameArena_isEntered();
+    const bool borrow1 = share && source->reserved1,
+               borrow2 = share && source->reserved2;
     *destination = (struct callstack_frame) {
         source->reserved,
-        source->reserved1,
-        source->reserved2,
+        borrow1,
+        borrow2,
         source->sourceFileOutdated,
         source->binaryFileIsSelf,
-        source->reserved1 ? source->binaryFile : utils_maybeCopySave(source->binaryFile, true),
-        source->reserved1 ? source->binaryFileRelative : utils_maybeCopySave(source->binaryFileRelative, true),
-        source->reserved2 ? source->function : utils_maybeCopySave(source->function, true),
-        source->reserved1 ? source->sourceFile : utils_maybeCopySave(source->sourceFile, true),
-        source->reserved1 ? source->sourceFileRelative : utils_maybeCopySave(source->sourceFileRelative, true),
+        borrow1 ? source->binaryFile : callstackFrameArena_copy(source->binaryFile),
+        borrow1 ? source->binaryFileRelative : callstackFrameArena_copy(source->binaryFileRelative),
+        borrow2 ? source->function : callstackFrameArena_copy(source->function),
+        borrow1 ? source->sourceFile : callstackFrameArena_copy(source->sourceFile),
+        borrow1 ? source->sourceFileRelative : callstackFrameArena_copy(source->sourceFileRelative),
         source->sourceLine,
         source->sourceLineColumn
     };
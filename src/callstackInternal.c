@@ -24,9 +24,13 @@
 #include <execinfo.h>
 #include <string.h>
 
+#include <callstack_internals.h>
+
+#include "callstackFrame/callstackFrameArena.h"
 #include "callstackFrame/callstackFrameInternal.h"
 #include "dlMapper/dlMapper.h"
 #include "parser/callstack_parser.h"
+#include "unwinder/unwinder.h"
 
 void callstack_createWithBacktrace(struct callstack * self,
                                    void * trace[], size_t traceLength) {
@@ -36,54 +40,196 @@ void callstack_createWithBacktrace(struct callstack * self,
     self->backtraceSize = traceLength;
 }
 
+/**
+ * @brief Removes all frames upon the given address from the given backtrace.
+ *
+ * If the given address is not found, the backtrace is not modified.
+ *
+ * @param buffer the backtrace
+ * @param frames the count of frames in the given backtrace
+ * @param address the address upon which to remove the frames
+ * @return the new count of frames or @c -1 if the address was not found
+ */
+static inline int callstack_removeFramesUpon(void* buffer[], const int frames, const void* address) {
+    int i;
+    for (i = 0; i < frames && buffer[i] != address; ++i);
+    if (i == frames) return -1;
+
+    (void) memmove(buffer, buffer + i, ((size_t) frames - i) * sizeof(void*));
+    return frames - i;
+}
+
+/**
+ * @brief Creates a backtrace using the given unwinding function.
+ *
+ * All frames upon the given address are removed from the generated backtrace.
+ *
+ * @param unwinder the unwinding function
+ * @param buffer the buffer to store the frame addresses in
+ * @param bufferSize the count of available elements in the given buffer
+ * @param address the address upon which frames are removed from the backtrace
+ * @param signalSafe whether to only use async-signal-safe functions
+ * @return the count of frame addresses stored in the given buffer or @c -1 if
+ * the stack could not be unwound up to the given address
+ */
+static inline int callstack_unwind(int (*unwinder)(void*[], int, bool),
+                                   void* buffer[], const int bufferSize, const void* address, const bool signalSafe) {
+    int frames = unwinder(buffer, bufferSize, signalSafe);
+#ifdef LCS_USE_BUILTINS
+    if (frames > 0) {
+        // If the address is not found, the unwinding went wrong.
+        frames = callstack_removeFramesUpon(buffer, frames, address);
+    }
+#else
+    (void) address;
+#endif
+    return frames;
+}
+
+/**
+ * @brief Creates a backtrace using the selected unwinder.
+ *
+ * The function @c backtrace is never used by this function.
+ *
+ * @param buffer the buffer to store the frame addresses in
+ * @param bufferSize the count of available elements in the given buffer
+ * @param address the address upon which frames are removed from the backtrace
+ * @param signalSafe whether to only use async-signal-safe functions
+ * @return the count of frame addresses stored in the given buffer or @c -1 if
+ * the stack could not be unwound
+ */
+static inline int callstack_unwindSelected(void* buffer[], const int bufferSize, const void* address,
+                                           const bool signalSafe) {
+    int frames = -1;
+    switch (callstack_unwinder) {
+        case CALLSTACK_UNWINDER_CFI:
+            frames = callstack_unwind(unwinder_cfi, buffer, bufferSize, address, signalSafe);
+            if (frames > 0) break;
+            // fall through
+
+        case CALLSTACK_UNWINDER_FRAME_POINTER:
+            frames = callstack_unwind(unwinder_framePointer, buffer, bufferSize, address, signalSafe);
+            break;
+
+        default:
+            // The function backtrace is not async-signal-safe, the frame pointers are walked instead.
+            if (signalSafe) {
+                frames = callstack_unwind(unwinder_framePointer, buffer, bufferSize, address, signalSafe);
+            }
+            break;
+    }
+    return frames;
+}
+
 int callstack_backtrace(void* buffer[], const int bufferSize, const void* address) {
-    const int frames = backtrace(buffer, bufferSize);
-    int i = 0;
+    int frames = callstack_unwindSelected(buffer, bufferSize, address, false);
+    if (frames > 0) return frames;
 
+    frames = backtrace(buffer, bufferSize);
     if (frames < 0) return frames;
-    
+
 #ifdef LCS_USE_BUILTINS
-    for (i = 0; buffer[i] != address && i < bufferSize; ++i);
-    (void) memmove(buffer, buffer + i, ((size_t) bufferSize - i) * sizeof(void *));
+    const int remaining = callstack_removeFramesUpon(buffer, frames, address);
+    if (remaining >= 0) {
+        frames = remaining;
+    }
 #else
     (void) address;
 #endif
-    return frames - i;
+    return frames;
 }
 
-enum callstack_type callstack_translate(struct callstack * self) {
-    if (self->frames == NULL && callstack_translateBinaries(self, false) == FAILED) {
-        return FAILED;
+int callstack_backtraceSignalSafe(void* buffer[], const int bufferSize, const void* address) {
+    return callstack_unwindSelected(buffer, bufferSize, address, true);
+}
+
+struct callstack_frame* callstack_translateBinariesOf(void* const backtrace[], const size_t count,
+                                                      const bool useCache) {
+    struct callstack_frame* frames = callstackFrameArena_newFrames(count);
+    if (frames == NULL) {
+        return NULL;
+    }
+
+    struct callstackFrameArena* previous = callstackFrameArena_enter(callstackFrameArena_of(frames));
+    dlMapper_readLock();
+    for (size_t i = 0; i < count; ++i) {
+        callstackFrame_translateBinary(&frames[i], backtrace[i], useCache, false);
+    }
+    dlMapper_readUnlock();
+    callstackFrameArena_leave(previous);
+    return frames;
+}
+
+struct callstack_frame* callstack_copyFrames(const struct callstack_frame frames[], const size_t count) {
+    struct callstack_frame* toReturn = callstackFrameArena_newFrames(count);
+    if (toReturn == NULL) {
+        return NULL;
+    }
+
+    struct callstackFrameArena* previous = callstackFrameArena_enter(callstackFrameArena_of(toReturn));
+    // The borrowed strings are shared, their binary files need to be kept alive by the copy, too.
+    const bool retained = callstackFrameArena_retainAll(callstackFrameArena_of((struct callstack_frame*) frames));
+    if (!retained) {
+        callstackFrameArena_leave(previous);
+        callstackFrameArena_deleteFrames(toReturn);
+        return NULL;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        callstack_frame_copyHere(&toReturn[i], &frames[i]);
+    }
+    callstackFrameArena_leave(previous);
+    return toReturn;
+}
+
+void callstack_refreshBinariesOf(void* const backtrace[], struct callstack_frame frames[], const size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        if (frames[i].function == NULL) {
+            frames[i].reserved = dlMapper_binaryFileForAddress(backtrace[i], false);
+        }
     }
-    
+}
+
+bool callstack_translateFrames(void* const backtrace[], struct callstack_frame frames[], const size_t first,
+                               const size_t count) {
+    struct callstackFrameArena* previous = callstackFrameArena_enter(callstackFrameArena_of(frames));
     struct callstack_parser parser;
     callstack_parser_create(&parser);
-    self->translationStatus = callstack_parser_parse(&parser, self);
+    const bool success = callstack_parser_parseFrames(&parser, backtrace + first, frames + first, count);
     callstack_parser_destroy(&parser);
+    callstackFrameArena_leave(previous);
+    return success;
+}
+
+enum callstack_type callstack_translate(struct callstack * self) {
+    // The binary files of the frames need to stay loaded until they are translated.
+    dlMapper_readLock();
+    if (self->frames != NULL) {
+        callstack_refreshBinariesOf(self->backtrace, self->frames, self->backtraceSize);
+    } else if (callstack_translateBinaries(self, callstack_zeroCopy) == FAILED) {
+        dlMapper_readUnlock();
+        return FAILED;
+    }
+
+    self->translationStatus = TRANSLATED;
+    if (!callstack_translateFrames(self->backtrace, self->frames, 0, self->backtraceSize)) {
+        callstack_reset(self);
+        self->translationStatus = FAILED;
+    }
+    dlMapper_readUnlock();
     return self->translationStatus;
 }
 
 enum callstack_type callstack_translateBinaries(struct callstack* self, const bool useCache) {
-    self->frames = malloc(sizeof(struct callstack_frame) * self->backtraceSize);
+    self->frames = callstack_translateBinariesOf(self->backtrace, self->backtraceSize, useCache);
     if (self->frames == NULL) {
         return FAILED;
     }
     self->frameCount = self->backtraceSize;
-
-    dlMapper_init();
-    for (size_t i = 0; i < self->backtraceSize; ++i) {
-        callstackFrame_translateBinary(&self->frames[i], self->backtrace[i], useCache, false);
-    }
     return TRANSLATED;
 }
 
 void callstack_reset(struct callstack * self) {
-    if (self->frames != NULL) {
-        for (size_t i = 0; i < self->frameCount; ++i) {
-            callstack_frame_destroy(&self->frames[i]);
-        }
-        free(self->frames);
-        self->frameCount = 0;
-        self->frames = NULL;
-    }
+    callstackFrameArena_deleteFrames(self->frames);
+    self->frameCount = 0;
+    self->frames = NULL;
 }
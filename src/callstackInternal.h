@@ -1,7 +1,7 @@
 /*
  * CallstackLibrary - Library creating human-readable call stacks.
  *
- * Copyright (C) 2022 - 2025  mhahnFr
+ * Copyright (C) 2022 - 2026  mhahnFr
  *
  * This file is part of the CallstackLibrary.
  *
@@ -60,6 +60,20 @@ void callstack_createWithBacktrace(struct callstack * self,
  */
 int callstack_backtrace(void* buffer[], int bufferSize, const void* address);
 
+/**
+ * @brief Creates a backtrace into the given buffer using async-signal-safe
+ * functions only.
+ *
+ * All frames upon the given address are removed from the generated backtrace.
+ *
+ * @param buffer the buffer to store the frame addresses in
+ * @param bufferSize the count of available elements in the given buffer
+ * @param address the address upon which frames are removed from the backtrace
+ * @return the count of frame addresses stored in the given buffer or @c -1 if
+ * the stack could not be unwound
+ */
+int callstack_backtraceSignalSafe(void* buffer[], int bufferSize, const void* address);
+
 /**
  * @brief Translates the given callstack object into a human-readable format.
  *
@@ -79,6 +93,56 @@ enum callstack_type callstack_translate(struct callstack * self);
  */
 enum callstack_type callstack_translateBinaries(struct callstack* self, bool useCache);
 
+/**
+ * @brief Deducts the binary files of the given backtrace.
+ *
+ * @param backtrace the addresses to be translated
+ * @param count the count of addresses
+ * @param useCache whether to use cached values instead of copies
+ * @return the callstack frames allocated with their arena or @c NULL if the allocation failed
+ */
+struct callstack_frame* callstack_translateBinariesOf(void* const backtrace[], size_t count, bool useCache);
+
+/**
+ * @brief Copies the given callstack frames.
+ *
+ * The strings of the copied frames are allocated in the arena of the copy.
+ *
+ * @param frames the callstack frames to be copied
+ * @param count the count of frames
+ * @return the copied callstack frames allocated with their arena or @c NULL if the allocation failed
+ */
+struct callstack_frame* callstack_copyFrames(const struct callstack_frame frames[], size_t count);
+
+/**
+ * @brief Deducts the binary files of the given callstack frames that have not
+ * been translated yet again.
+ *
+ * The binary files deducted earlier may have been released by clearing the
+ * caches in the meantime. Needs to be called inside of a read section of the
+ * dlMapper.
+ *
+ * @param backtrace the addresses of the frames
+ * @param frames the callstack frames
+ * @param count the count of frames
+ */
+void callstack_refreshBinariesOf(void* const backtrace[], struct callstack_frame frames[], size_t count);
+
+/**
+ * @brief Translates the given callstack frames into a human-readable format.
+ *
+ * The binary files of the given frames need to be deducted already. Frames
+ * that have already been translated are skipped. The strings of the frames
+ * are allocated in the arena of the given array.
+ *
+ * @param backtrace the addresses of all frames
+ * @param frames all callstack frames, allocated with their arena
+ * @param first the index of the first frame to be translated
+ * @param count the count of frames to be translated
+ * @return whether the frames were translated
+ */
+bool callstack_translateFrames(void* const backtrace[], struct callstack_frame frames[], size_t first, size_t count);
+
 /**
  * Removes all translated callstack frames from the given callstack object.
  *
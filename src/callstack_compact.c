@@ -0,0 +1,168 @@
+/*
+ * CallstackLibrary - Library creating human-readable call stacks.
+ *
+ * Copyright (C) 2026  mhahnFr
+ *
+ * This file is part of the CallstackLibrary.
+ *
+ * The CallstackLibrary is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The CallstackLibrary is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with the
+ * CallstackLibrary, see the file LICENSE.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <callstack_compact.h>
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <callstack_internals.h>
+
+#include "callstackInternal.h"
+#include "lcs_builtins.h"
+#include "callstackFrame/callstackFrameArena.h"
+#include "dlMapper/dlMapper.h"
+
+/**
+ * @brief Stores the given backtrace into the given compact callstack.
+ *
+ * If the given backtrace is allocated, it is taken over on success.
+ *
+ * @param self the compact callstack object
+ * @param trace the backtrace
+ * @param traceLength the length of the given backtrace
+ * @param allocated whether the given backtrace is allocated and can be taken over
+ * @return whether the backtrace was stored successfully
+ */
+static inline bool callstack_compact_store(struct callstack_compact* self, void* trace[], const size_t traceLength,
+                                           const bool allocated) {
+    *self = (struct callstack_compact) CALLSTACK_COMPACT_INITIALIZER;
+    if (traceLength <= CALLSTACK_COMPACT_INLINE_SIZE) {
+        memcpy(self->backtrace.inlined, trace, traceLength * sizeof(void*));
+        if (allocated) {
+            free(trace);
+        }
+    } else if (allocated) {
+        void** shrunk = realloc(trace, traceLength * sizeof(void*));
+        self->backtrace.allocated = shrunk == NULL ? trace : shrunk;
+    } else {
+        self->backtrace.allocated = malloc(traceLength * sizeof(void*));
+        if (self->backtrace.allocated == NULL) {
+            return false;
+        }
+        memcpy(self->backtrace.allocated, trace, traceLength * sizeof(void*));
+    }
+    self->backtraceSize = traceLength;
+    return true;
+}
+
+/**
+ * @brief Constructs the given compact callstack object.
+ *
+ * All frames upon the given address are removed.
+ *
+ * @param self the compact callstack object
+ * @param address the address upon which frames are removed
+ * @param maxDepth the maximum amount of frames to be stored
+ * @return whether the callstack was constructed successfully
+ */
+static inline bool callstack_compact_emplaceWithAddress(struct callstack_compact* self, const void* address,
+                                                        const size_t maxDepth) {
+    if (maxDepth <= CALLSTACK_BACKTRACE_SIZE) {
+        // The frames of the library need to fit into the buffer in order to be removed.
+        void* trace[CALLSTACK_BACKTRACE_SIZE];
+        const int size = callstack_backtrace(trace, CALLSTACK_BACKTRACE_SIZE, address);
+        if (size < 0) return false;
+
+        const size_t count = (size_t) size < maxDepth ? (size_t) size : maxDepth;
+        return callstack_compact_store(self, trace, count, false);
+    }
+
+    const int bufferSize = maxDepth > INT_MAX ? INT_MAX : (int) maxDepth;
+    void** trace = malloc((size_t) bufferSize * sizeof(void*));
+    if (trace == NULL) return false;
+
+    const int size = callstack_backtrace(trace, bufferSize, address);
+    if (size < 0) {
+        free(trace);
+        return false;
+    }
+    return callstack_compact_store(self, trace, (size_t) size, true);
+}
+
+bool callstack_compact_emplace(struct callstack_compact* self) {
+    return callstack_compact_emplaceWithAddress(self, lcs_returnAddress(0), CALLSTACK_BACKTRACE_SIZE);
+}
+
+bool callstack_compact_emplaceWithDepth(struct callstack_compact* self, const size_t maxDepth) {
+    return callstack_compact_emplaceWithAddress(self, lcs_returnAddress(0), maxDepth);
+}
+
+bool callstack_compact_emplaceWithBacktrace(struct callstack_compact* self, void* const trace[],
+                                            const size_t traceLength) {
+    return callstack_compact_store(self, (void**) trace, traceLength, false);
+}
+
+bool callstack_compact_copy(struct callstack_compact* self, const struct callstack_compact* other) {
+    if (other == self) return true;
+
+    callstack_compact_destroy(self);
+    if (!callstack_compact_store(self, (void**) callstack_compact_getBacktrace(other), other->backtraceSize, false)) {
+        return false;
+    }
+    self->translationStatus = other->translationStatus;
+    if (other->frameCount != 0) {
+        self->frames = callstack_copyFrames(other->frames, other->frameCount);
+        if (self->frames == NULL) {
+            self->translationStatus = NONE;
+            return true;
+        }
+        self->frameCount = other->frameCount;
+    }
+    return true;
+}
+
+struct callstack_frame* callstack_compact_toArray(struct callstack_compact* self) {
+    if (self == NULL) return NULL;
+
+    if (self->translationStatus == NONE) {
+        void* const* backtrace = callstack_compact_getBacktrace(self);
+        dlMapper_readLock();
+        if (self->frames != NULL) {
+            callstack_refreshBinariesOf(backtrace, self->frames, self->frameCount);
+        } else {
+            self->frames = callstack_translateBinariesOf(backtrace, self->backtraceSize, callstack_zeroCopy);
+            if (self->frames == NULL) {
+                dlMapper_readUnlock();
+                return NULL;
+            }
+            self->frameCount = self->backtraceSize;
+        }
+        self->translationStatus = TRANSLATED;
+        if (!callstack_translateFrames(backtrace, self->frames, 0, self->backtraceSize)) {
+            callstackFrameArena_deleteFrames(self->frames);
+            self->frames            = NULL;
+            self->frameCount        = 0;
+            self->translationStatus = FAILED;
+        }
+        dlMapper_readUnlock();
+    }
+    return self->frames;
+}
+
+void callstack_compact_destroy(struct callstack_compact* self) {
+    if (self->backtraceSize > CALLSTACK_COMPACT_INLINE_SIZE) {
+        free(self->backtrace.allocated);
+    }
+    callstackFrameArena_deleteFrames(self->frames);
+    *self = (struct callstack_compact) CALLSTACK_COMPACT_INITIALIZER;
+}
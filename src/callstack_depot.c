@@ -0,0 +1,238 @@
+/*
+ * CallstackLibrary - Library creating human-readable call stacks.
+ *
+ * Copyright (C) 2026  mhahnFr
+ *
+ * This file is part of the CallstackLibrary.
+ *
+ * The CallstackLibrary is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The CallstackLibrary is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with the
+ * CallstackLibrary, see the file LICENSE.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <callstack_depot.h>
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include <callstack.h>
+
+#include "callstackInternal.h"
+#include "lcs_builtins.h"
+
+/** The count of buckets of the hash table; has to be a power of two.         */
+#define CALLSTACK_DEPOT_BUCKETS     (1 << 18)
+/** The count of bits of an identifier used for the offset inside of a chunk. */
+#define CALLSTACK_DEPOT_OFFSET_BITS 17
+/** The size of an arena chunk, addressable in units of eight bytes.          */
+#define CALLSTACK_DEPOT_CHUNK_SIZE  ((uint32_t) 8 << CALLSTACK_DEPOT_OFFSET_BITS)
+/** The maximum count of arena chunks.                                        */
+#define CALLSTACK_DEPOT_CHUNKS      (1 << (32 - CALLSTACK_DEPOT_OFFSET_BITS))
+
+/**
+ * An interned backtrace, stored in the arena.
+ */
+struct callstack_depotRecord {
+    /** The next record in the same bucket.  */
+    struct callstack_depotRecord* _Atomic next;
+    /** The hash of the backtrace.           */
+    uint32_t hash;
+    /** The length of the backtrace.         */
+    uint32_t length;
+    /** The identifier of this record.       */
+    uint32_t id;
+    /** The backtrace.                       */
+    void* frames[];
+};
+
+/** The buckets of the hash table, each one a list of records.                       */
+static struct callstack_depotRecord* _Atomic callstack_depot_buckets[CALLSTACK_DEPOT_BUCKETS];
+/** The chunks of the arena; the first one is never used, making @c 0 an invalid id. */
+static char* _Atomic callstack_depot_chunks[CALLSTACK_DEPOT_CHUNKS];
+/** The current chunk in the upper and the used bytes of it in the lower 32 bits.   */
+static _Atomic uint64_t callstack_depot_arena = CALLSTACK_DEPOT_CHUNK_SIZE;
+
+/**
+ * Hashes the given backtrace.
+ *
+ * @param trace the backtrace
+ * @param length the length of the backtrace
+ * @return the hash value
+ */
+static inline uint32_t callstack_depot_hash(void* const trace[], const size_t length) {
+    uint64_t hash = length * UINT64_C(0x9e3779b97f4a7c15);
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= (uintptr_t) trace[i];
+        hash *= UINT64_C(0xff51afd7ed558ccd);
+        hash ^= hash >> 32;
+    }
+    return (uint32_t) hash;
+}
+
+/**
+ * @brief Allocates the given amount of bytes in the arena.
+ *
+ * The chunks are mapped directly, since the stack depot may be used from
+ * within allocation functions.
+ *
+ * @param size the amount of bytes, a multiple of eight
+ * @param id the identifier of the allocated memory to be filled
+ * @return the allocated memory or @c NULL if the arena is exhausted
+ */
+static inline void* callstack_depot_allocate(const uint32_t size, uint32_t* id) {
+    uint64_t state = atomic_load_explicit(&callstack_depot_arena, memory_order_acquire);
+    for (;;) {
+        const uint32_t chunk  = (uint32_t) (state >> 32);
+        const uint32_t offset = (uint32_t) state;
+
+        if (CALLSTACK_DEPOT_CHUNK_SIZE - offset >= size) {
+            if (atomic_compare_exchange_weak_explicit(&callstack_depot_arena, &state, state + size,
+                                                      memory_order_acq_rel, memory_order_acquire)) {
+                *id = chunk << CALLSTACK_DEPOT_OFFSET_BITS | offset >> 3;
+                return atomic_load_explicit(&callstack_depot_chunks[chunk], memory_order_acquire) + offset;
+            }
+            continue;
+        }
+
+        const uint32_t next = chunk + 1;
+        if (next >= CALLSTACK_DEPOT_CHUNKS) return NULL;
+
+        if (atomic_load_explicit(&callstack_depot_chunks[next], memory_order_acquire) == NULL) {
+            char* memory = mmap(NULL, CALLSTACK_DEPOT_CHUNK_SIZE, PROT_READ | PROT_WRITE,
+                                MAP_PRIVATE | MAP_ANON, -1, 0);
+            if (memory == MAP_FAILED) return NULL;
+
+            char* expected = NULL;
+            if (!atomic_compare_exchange_strong_explicit(&callstack_depot_chunks[next], &expected, memory,
+                                                         memory_order_acq_rel, memory_order_acquire)) {
+                munmap(memory, CALLSTACK_DEPOT_CHUNK_SIZE);
+            }
+        }
+        const uint64_t newState = (uint64_t) next << 32 | size;
+        if (atomic_compare_exchange_strong_explicit(&callstack_depot_arena, &state, newState,
+                                                    memory_order_acq_rel, memory_order_acquire)) {
+            *id = next << CALLSTACK_DEPOT_OFFSET_BITS;
+            return atomic_load_explicit(&callstack_depot_chunks[next], memory_order_acquire);
+        }
+    }
+}
+
+/**
+ * @brief Returns the record with the given identifier.
+ *
+ * The record has to lie within the used part of its chunk and has to carry
+ * the given identifier; the unused rest of a chunk is zero-filled, which is
+ * never a valid identifier. The frames are not rehashed, keeping the lookup
+ * independent of the length of the backtrace.
+ *
+ * @param id the identifier
+ * @return the record or @c NULL if the identifier is invalid
+ */
+static inline struct callstack_depotRecord* callstack_depot_record(const uint32_t id) {
+    const uint32_t chunk  = id >> CALLSTACK_DEPOT_OFFSET_BITS;
+    const uint32_t offset = (id & ((1 << CALLSTACK_DEPOT_OFFSET_BITS) - 1)) << 3;
+
+    const uint64_t state = atomic_load_explicit(&callstack_depot_arena, memory_order_acquire);
+    const uint32_t current = (uint32_t) (state >> 32);
+    if (chunk == 0 || chunk > current) return NULL;
+
+    const uint32_t used = chunk == current ? (uint32_t) state : CALLSTACK_DEPOT_CHUNK_SIZE;
+    if (used < sizeof(struct callstack_depotRecord) || offset > used - sizeof(struct callstack_depotRecord)) {
+        return NULL;
+    }
+    char* memory = atomic_load_explicit(&callstack_depot_chunks[chunk], memory_order_acquire);
+    if (memory == NULL) return NULL;
+
+    struct callstack_depotRecord* record = (struct callstack_depotRecord*) (memory + offset);
+    if (record->id != id
+        || record->length > (used - offset - sizeof(struct callstack_depotRecord)) / sizeof(void*)) {
+        return NULL;
+    }
+    return record;
+}
+
+/**
+ * Searches the given list of records for the given backtrace.
+ *
+ * @param record the first record to be checked
+ * @param end the record upon which to stop searching
+ * @param hash the hash of the backtrace
+ * @param trace the backtrace
+ * @param length the length of the backtrace
+ * @return the found record or @c NULL if not found
+ */
+static inline struct callstack_depotRecord* callstack_depot_find(struct callstack_depotRecord* record,
+                                                                const struct callstack_depotRecord* end,
+                                                                const uint32_t hash,
+                                                                void* const trace[], const size_t length) {
+    for (; record != end; record = atomic_load_explicit(&record->next, memory_order_acquire)) {
+        if (record->hash == hash && record->length == length
+            && memcmp(record->frames, trace, length * sizeof(void*)) == 0) {
+            return record;
+        }
+    }
+    return NULL;
+}
+
+uint32_t callstack_intern(void* const trace[], const size_t length) {
+    const size_t size = sizeof(struct callstack_depotRecord) + length * sizeof(void*);
+    if (size > CALLSTACK_DEPOT_CHUNK_SIZE) return 0;
+
+    const uint32_t hash = callstack_depot_hash(trace, length);
+    struct callstack_depotRecord* _Atomic* bucket = &callstack_depot_buckets[hash & (CALLSTACK_DEPOT_BUCKETS - 1)];
+
+    struct callstack_depotRecord* head = atomic_load_explicit(bucket, memory_order_acquire);
+    struct callstack_depotRecord* found = callstack_depot_find(head, NULL, hash, trace, length);
+    if (found != NULL) {
+        return found->id;
+    }
+
+    uint32_t id;
+    struct callstack_depotRecord* record = callstack_depot_allocate((uint32_t) size, &id);
+    if (record == NULL) return 0;
+
+    record->hash   = hash;
+    record->length = (uint32_t) length;
+    record->id     = id;
+    memcpy(record->frames, trace, length * sizeof(void*));
+    for (;;) {
+        atomic_store_explicit(&record->next, head, memory_order_relaxed);
+
+        struct callstack_depotRecord* const previous = head;
+        if (atomic_compare_exchange_weak_explicit(bucket, &head, record,
+                                                  memory_order_release, memory_order_acquire)) {
+            return id;
+        }
+        // Someone else might have interned the same backtrace in the meantime.
+        found = callstack_depot_find(head, previous, hash, trace, length);
+        if (found != NULL) {
+            // The allocated record is abandoned; the arena cannot free.
+            return found->id;
+        }
+    }
+}
+
+uint32_t callstack_internBacktrace(void) {
+    void* trace[CALLSTACK_BACKTRACE_SIZE];
+    const int size = callstack_backtraceSignalSafe(trace, CALLSTACK_BACKTRACE_SIZE, lcs_returnAddress(0));
+    return size < 0 ? 0 : callstack_intern(trace, (size_t) size);
+}
+
+void* const* callstack_getInterned(const uint32_t id, size_t* length) {
+    const struct callstack_depotRecord* record = callstack_depot_record(id);
+    if (record == NULL) return NULL;
+
+    *length = record->length;
+    return record->frames;
+}
@@ -1,7 +1,7 @@
 /*
  * CallstackLibrary - Library creating human-readable call stacks.
  *
- * Copyright (C) 2023 - 2025  mhahnFr
+ * Copyright (C) 2023 - 2026  mhahnFr
  *
  * This file is part of the CallstackLibrary.
  *
@@ -22,13 +22,21 @@
 #include <callstack_internals.h>
 
 #include "dlMapper/dlMapper.h"
-#include "parser/file/binaryFile.h"
 
 bool callstack_rawNames = false;
 
 bool callstack_autoClearCaches = true;
 
+bool callstack_zeroCopy = false;
+
+bool callstack_functionNamesOnly = false;
+
+#ifdef __linux__
+enum callstack_unwinderType callstack_unwinder = CALLSTACK_UNWINDER_CFI;
+#else
+enum callstack_unwinderType callstack_unwinder = CALLSTACK_UNWINDER_FRAME_POINTER;
+#endif
+
 void callstack_clearCaches(void) {
-    binaryFile_clearCaches();
     dlMapper_deinit();
 }
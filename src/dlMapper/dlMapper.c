@@ -21,104 +21,488 @@
 
 #include "dlMapper.h"
 
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "dlMapper_platform.h"
+#include "../parser/file/debugInfoCache.h"
+#include "../unwinder/unwinder.h"
 
-/** The loaded library infos.                            */
-static vector_binaryFile_t loadedLibs = vector_initializer;
-/** Indicates whether the dlMapper has been initialized. */
-static bool dlMapper_inited = false;
+/**
+ * A snapshot of the loaded library infos.
+ */
+struct dlMapper_snapshot {
+    /** The loaded runtime images.                                              */
+    vector_dlMapperImage_t images;
+    /** The loaded segments of all runtime images, sorted by their start address. */
+    vector_dlMapperSegment_t segments;
+    /** The library infos of all runtime images, created when first requested.  */
+    vector_binaryFile_t* _Atomic libs;
+    /** The generation of the loaded runtime images.                              */
+    uint64_t generation;
+    /** Whether runtime images have been unloaded once the snapshot is retired.   */
+    bool unloaded;
+    /** The next snapshot whose retirement is deferred by the same thread.       */
+    struct dlMapper_snapshot* next;
+};
 
 /**
- * @brief Returns how the two given loaded library infos compare.
- *
- * Sorted ascendingly.
- *
- * @param lhs the left-hand side value
- * @param rhs the right-hand side value
- * @return @c 0 if the two values compare equal or a value less than or greater
- * than @c 0 according to the sorting order
+ * The read section state of a thread.
  */
-static inline int dlMapper_sortCompare(const struct binaryFile** lhs, const struct binaryFile** rhs) {
+struct dlMapper_reader {
+    /** The nesting depth of the read sections of the thread.           */
+    size_t depth;
+    /** The parity of the epoch the thread registered itself in.         */
+    size_t parity;
+    /** The snapshot pinned by the read section.                          */
+    struct dlMapper_snapshot* snapshot;
+    /** Indicates whether a deinitialization was requested while reading. */
+    bool deinitPending;
+    /** Indicates whether the thread is currently loading a snapshot.     */
+    bool loading;
+    /** The index of the segment found by the last lookup of the thread.  */
+    size_t lastHit;
+    /** The snapshots replaced inside of the read section, to be retired.  */
+    struct dlMapper_snapshot* retired;
+};
+
+/** The currently published snapshot.                                   */
+static struct dlMapper_snapshot* _Atomic dlMapper_current = NULL;
+/** Indicates whether a lookup found the published snapshot outdated.   */
+static _Atomic bool dlMapper_outdated = false;
+/** The epoch, advanced whenever a snapshot is retired.                 */
+static _Atomic size_t dlMapper_epoch = 0;
+/** The counts of the active readers, by the parity of their epoch.     */
+static _Atomic size_t dlMapper_readers[2];
+/** The lock serializing the loading and the retiring of snapshots.     */
+static pthread_mutex_t dlMapper_writeLock = PTHREAD_MUTEX_INITIALIZER;
+/** The read section state of the calling thread.                       */
+static _Thread_local struct dlMapper_reader dlMapper_reader;
+/** The loaded library infos used when no snapshot is available.        */
+static const vector_binaryFile_t dlMapper_empty = vector_initializer;
+
+static inline int dlMapper_sortCompare(const struct dlMapper_segment* lhs, const struct dlMapper_segment* rhs) {
+    if (lhs->start < rhs->start) return -1;
+    if (lhs->start > rhs->start) return +1;
+    return 0;
+}
+
+static inline int dlMapper_sortCompareBinaries(struct binaryFile* const* lhs, struct binaryFile* const* rhs) {
     if ((*lhs)->startAddress < (*rhs)->startAddress) return -1;
     if ((*lhs)->startAddress > (*rhs)->startAddress) return +1;
     return 0;
 }
 
-bool dlMapper_init(void) {
-    if (dlMapper_inited) return true;
+static inline int dlMapper_searchCompare(const void* key, const struct dlMapper_segment* element) {
+    // IMPORTANT: key is the searched address, element the array element
 
-    const bool result = dlMapper_platform_loadLoadedLibraries(&loadedLibs);
-    if (!result) {
-        dlMapper_deinit();
-    } else {
-        vector_sort(&loadedLibs, dlMapper_sortCompare);
+    if (key >= element->start && key < element->end) {
+        return 0;
     }
-    return dlMapper_inited = result;
+    return key > element->start ? +1 : -1;
 }
 
-bool dlMapper_isInited(void) {
-    return dlMapper_inited;
+/**
+ * Waits until all readers possibly using a retired snapshot have left their
+ * read section.
+ */
+static inline void dlMapper_synchronize(void) {
+    const size_t epoch = atomic_fetch_add(&dlMapper_epoch, 1);
+    while (atomic_load_explicit(&dlMapper_readers[epoch & 1], memory_order_acquire) != 0) {
+        sched_yield();
+    }
 }
 
 /**
- * @brief Returns how the given key compares to the given loaded library info.
+ * @brief Deletes the given snapshot and releases the library infos in it.
  *
- * The given key is the searched address, the given element is a loaded library
- * info object.
+ * Library infos still referenced by translated callstacks stay alive.
  *
- * @param key the searched key
- * @param element the element to be checked
- * @return @c 0 if the key is in the loaded library or a value smaller or
- * greater than @c 0 according to the sorting order
+ * @param snapshot the snapshot to be deleted
  */
-static inline int dlMapper_searchCompare(const void* key, const struct binaryFile** element) {
-    // IMPORTANT: key is the searched address, element the array element
+static inline void dlMapper_snapshot_delete(struct dlMapper_snapshot* snapshot) {
+    vector_iterate(&snapshot->images, {
+        struct binaryFile* file = atomic_load_explicit(&element->file, memory_order_relaxed);
+        if (file != NULL) {
+            binaryFile_release(file);
+        }
+        free(element->fileName);
+    });
+    vector_destroy(&snapshot->images);
+    vector_destroy(&snapshot->segments);
 
-    const struct binaryFile* file = *element;
-    if (key >= file->startAddress && key < file->end) {
-        return 0;
+    vector_binaryFile_t* libs = atomic_load_explicit(&snapshot->libs, memory_order_relaxed);
+    if (libs != NULL) {
+        vector_destroy(libs);
+        free(libs);
     }
-    return key > file->startAddress ? +1 : -1;
+    free(snapshot);
 }
 
 /**
- * Compares the given key with the given element.
+ * @brief Returns the library info of the given runtime image.
  *
- * @param key the searched key
- * @param element the region element to be checked
- * @return a positive number if the key is bigger that the element, a negative
- * number if it is smaller or zero if the key is found within the given element
+ * The library info is created on the first request. If multiple threads
+ * create it concurrently, the first published one is used.
+ *
+ * @param image the runtime image
+ * @return the library info or @c NULL if it could not be created
  */
-static inline int dlMapper_searchCompareRegion(const void* key, const pair_ptr_t* element) {
-    const uintptr_t k = (uintptr_t) key;
-    if (k >= element->first && k < element->second) {
-        return 0;
+static inline struct binaryFile* dlMapper_image_getFile(struct dlMapper_image* image) {
+    struct binaryFile* file = atomic_load_explicit(&image->file, memory_order_acquire);
+    if (file != NULL) return file;
+
+    file = binaryFile_new(image->fileName, image->start);
+    if (file == NULL) return NULL;
+    file->relocationOffset = image->relocationOffset;
+    file->tls              = image->tls;
+
+    struct binaryFile* expected = NULL;
+    if (!atomic_compare_exchange_strong_explicit(&image->file, &expected, file,
+                                                 memory_order_acq_rel, memory_order_acquire)) {
+        binaryFile_release(file);
+        return expected;
     }
-    return k > element->first ? +1 : -1;
+    return file;
 }
 
-struct binaryFile* dlMapper_binaryFileForAddress(const void* address, const bool includeRegions) {
-    if (!dlMapper_inited) return NULL;
-
-    struct binaryFile** toReturn = vector_search(&loadedLibs, address, dlMapper_searchCompare);
-    if (toReturn == NULL && includeRegions) {
-        vector_iterate(&loadedLibs, {
-            const pair_ptr_t* result = vector_search(binaryFile_getRegions(*element),
-                                                     address, dlMapper_searchCompareRegion);
-            if (result != NULL) {
-                return *element;
+/**
+ * @brief Returns the library infos of all runtime images of the given snapshot,
+ * sorted by their start address.
+ *
+ * The library infos not yet created are created.
+ *
+ * @param snapshot the snapshot
+ * @return the library infos
+ */
+static inline const vector_binaryFile_t* dlMapper_snapshot_getBinaries(struct dlMapper_snapshot* snapshot) {
+    vector_binaryFile_t* libs = atomic_load_explicit(&snapshot->libs, memory_order_acquire);
+    if (libs != NULL) return libs;
+
+    libs = malloc(sizeof(vector_binaryFile_t));
+    if (libs == NULL) return &dlMapper_empty;
+
+    vector_init(libs);
+    vector_reserve(libs, snapshot->images.count);
+    vector_iterate(&snapshot->images, {
+        struct binaryFile* file = dlMapper_image_getFile(element);
+        if (file != NULL) {
+            vector_push_back(libs, file);
+        }
+    });
+    vector_sort(libs, dlMapper_sortCompareBinaries);
+    vector_binaryFile_t* expected = NULL;
+    if (!atomic_compare_exchange_strong_explicit(&snapshot->libs, &expected, libs,
+                                                 memory_order_acq_rel, memory_order_acquire)) {
+        vector_destroy(libs);
+        free(libs);
+        return expected;
+    }
+    return libs;
+}
+
+/**
+ * @brief Returns the loaded segment of the given snapshot the given address
+ * belongs to.
+ *
+ * The segment found by the last lookup of the calling thread is tried first.
+ *
+ * @param snapshot the snapshot
+ * @param address the address
+ * @return the segment or @c NULL if the address does not belong to any loaded segment
+ */
+static inline const struct dlMapper_segment* dlMapper_snapshot_findSegment(const struct dlMapper_snapshot* snapshot,
+                                                                           const void* address) {
+    if (dlMapper_reader.lastHit < snapshot->segments.count) {
+        const struct dlMapper_segment* segment = &snapshot->segments.content[dlMapper_reader.lastHit];
+        if (address >= segment->start && address < segment->end) {
+            return segment;
+        }
+    }
+    const struct dlMapper_segment* segment = vector_search(&snapshot->segments, address, dlMapper_searchCompare);
+    if (segment != NULL) {
+        dlMapper_reader.lastHit = (size_t) (segment - snapshot->segments.content);
+    }
+    return segment;
+}
+
+/**
+ * Returns the snapshot to be used by the calling thread.
+ *
+ * @return the pinned snapshot if inside of a read section, the published one otherwise
+ */
+static inline struct dlMapper_snapshot* dlMapper_snapshot(void) {
+    if (dlMapper_reader.depth > 0) {
+        return dlMapper_reader.snapshot;
+    }
+    return atomic_load_explicit(&dlMapper_current, memory_order_acquire);
+}
+
+/**
+ * @brief Takes over the library infos of the given previous snapshot for the
+ * runtime images that are still loaded.
+ *
+ * Runtime images are considered to be the same if they are loaded at the same
+ * address under the same name.
+ *
+ * @param snapshot the newly loaded snapshot
+ * @param previous the previous snapshot
+ * @return whether all runtime images of the previous snapshot are still loaded
+ */
+static inline bool dlMapper_snapshot_takeOver(struct dlMapper_snapshot* snapshot,
+                                              struct dlMapper_snapshot* previous) {
+    size_t kept = 0;
+    vector_iterate(&snapshot->images, {
+        const struct dlMapper_segment* segment = dlMapper_snapshot_findSegment(previous, element->start);
+        struct dlMapper_image* old = segment == NULL ? NULL : &previous->images.content[segment->image];
+        if (old != NULL && old->start == element->start && strcmp(old->fileName, element->fileName) == 0) {
+            ++kept;
+            struct binaryFile* file = atomic_load_explicit(&old->file, memory_order_acquire);
+            if (file != NULL) {
+                struct binaryFile* created = atomic_load_explicit(&element->file, memory_order_relaxed);
+                if (created != NULL) {
+                    binaryFile_release(created);
+                }
+                atomic_store_explicit(&element->file, binaryFile_retain(file), memory_order_relaxed);
             }
-        });
+        }
+    });
+    return kept == previous->images.count;
+}
+
+/**
+ * @brief Retires the given snapshot, replaced by a newly published one.
+ *
+ * If runtime images have been unloaded, the caches keyed by absolute
+ * addresses are invalidated, since other runtime images might be loaded at
+ * the same addresses. Readers that might have loaded cached information of
+ * the unloaded images are waited for before these are released.
+ *
+ * @param snapshot the snapshot to be retired
+ * @param unloaded whether runtime images have been unloaded
+ */
+static inline void dlMapper_retire(struct dlMapper_snapshot* snapshot, const bool unloaded) {
+    dlMapper_synchronize();
+    if (unloaded) {
+        debugInfoCache_invalidate();
+        unwinder_cfi_invalidateCache();
+        dlMapper_synchronize();
     }
-    return toReturn == NULL ? NULL : *toReturn;
+    dlMapper_snapshot_delete(snapshot);
+}
+
+/**
+ * @brief Loads and publishes a snapshot of the loaded library infos if none
+ * is published yet or if runtime images have been loaded or unloaded since
+ * the published one was loaded.
+ *
+ * The library infos of the runtime images still loaded are taken over from
+ * the outdated snapshot, which is returned to be retired by the caller. The
+ * write lock needs to be held.
+ *
+ * @return the replaced snapshot or @c NULL if none was replaced
+ */
+static inline struct dlMapper_snapshot* dlMapper_update(void) {
+    atomic_store_explicit(&dlMapper_outdated, false, memory_order_relaxed);
+    struct dlMapper_snapshot* current = atomic_load_explicit(&dlMapper_current, memory_order_relaxed);
+    if (current != NULL && current->generation == dlMapper_platform_loadGeneration()) return NULL;
+
+    struct dlMapper_snapshot* snapshot = malloc(sizeof(struct dlMapper_snapshot));
+    if (snapshot == NULL) return NULL;
+
+    vector_init(&snapshot->images);
+    vector_init(&snapshot->segments);
+    atomic_init(&snapshot->libs, NULL);
+    snapshot->unloaded = false;
+    snapshot->next     = NULL;
+    dlMapper_reader.loading = true;
+    const bool loaded = dlMapper_platform_loadLoadedLibraries(&snapshot->images, &snapshot->segments,
+                                                              &snapshot->generation);
+    dlMapper_reader.loading = false;
+    if (!loaded) {
+        dlMapper_snapshot_delete(snapshot);
+        return NULL;
+    }
+    vector_sort(&snapshot->segments, dlMapper_sortCompare);
+    if (current != NULL) {
+        current->unloaded = !dlMapper_snapshot_takeOver(snapshot, current);
+    }
+    atomic_store_explicit(&dlMapper_current, snapshot, memory_order_release);
+    return current;
+}
+
+/**
+ * @brief Loads and publishes a snapshot of the loaded library infos if
+ * necessary.
+ *
+ * A published snapshot is only checked against the loaded runtime images if
+ * requested, if a lookup found it to be outdated or if the platform can tell
+ * without taking any lock that runtime images have been loaded or unloaded.
+ * If called recursively while loading a snapshot, the outdated snapshot is kept.
+ *
+ * @param refresh whether to check the published snapshot in any case
+ * @return whether a snapshot is published
+ */
+static inline bool dlMapper_load(const bool refresh) {
+    struct dlMapper_snapshot* current = atomic_load_explicit(&dlMapper_current, memory_order_acquire);
+    if (current != NULL && !refresh && !atomic_load_explicit(&dlMapper_outdated, memory_order_relaxed)
+        && !dlMapper_platform_isOutdated(current->generation)) {
+        return true;
+    }
+    if (dlMapper_reader.loading) return current != NULL;
+
+    pthread_mutex_lock(&dlMapper_writeLock);
+    struct dlMapper_snapshot* replaced = dlMapper_update();
+    if (replaced != NULL) {
+        dlMapper_retire(replaced, replaced->unloaded);
+    }
+    const bool result = atomic_load_explicit(&dlMapper_current, memory_order_relaxed) != NULL;
+    pthread_mutex_unlock(&dlMapper_writeLock);
+    return result;
+}
+
+/**
+ * @brief Refreshes the snapshot used by the calling thread after a lookup
+ * missed it.
+ *
+ * Inside of a read section a newer snapshot is published and pinned instead;
+ * the replaced one stays alive until the outermost read section is left.
+ * If another thread is loading or retiring a snapshot, it waits for the calling
+ * reader: The published snapshot is only marked as outdated, to be refreshed
+ * by the next read section.
+ *
+ * @return whether a different snapshot is used now
+ */
+static inline bool dlMapper_refresh(void) {
+    struct dlMapper_snapshot* previous = dlMapper_snapshot();
+    if (dlMapper_reader.depth == 0) {
+        return dlMapper_load(true) && dlMapper_snapshot() != previous;
+    }
+    if (dlMapper_reader.loading || pthread_mutex_trylock(&dlMapper_writeLock) != 0) {
+        atomic_store_explicit(&dlMapper_outdated, true, memory_order_relaxed);
+        return false;
+    }
+    struct dlMapper_snapshot* replaced = dlMapper_update();
+    if (replaced != NULL) {
+        if (replaced->unloaded) {
+            debugInfoCache_invalidate();
+            unwinder_cfi_invalidateCache();
+        }
+        replaced->next = dlMapper_reader.retired;
+        dlMapper_reader.retired = replaced;
+    }
+    // Writers wait for this reader, the published snapshot therefore stays alive while it is registered.
+    struct dlMapper_snapshot* current = atomic_load_explicit(&dlMapper_current, memory_order_relaxed);
+    pthread_mutex_unlock(&dlMapper_writeLock);
+    if (current == NULL || current == previous) return false;
+
+    dlMapper_reader.snapshot = current;
+    dlMapper_reader.lastHit  = 0;
+    return true;
+}
+
+bool dlMapper_init(void) {
+    if (dlMapper_reader.depth > 0) {
+        // Writers wait for the readers, the snapshot is therefore loaded before entering the read section.
+        return dlMapper_reader.snapshot != NULL;
+    }
+    return dlMapper_load(true);
+}
+
+bool dlMapper_isInited(void) {
+    return dlMapper_snapshot() != NULL;
+}
+
+/**
+ * @brief Registers the calling thread as reader in the current epoch.
+ *
+ * Returns the parity of the epoch the thread has been registered in.
+ *
+ * @return the parity of the epoch
+ */
+static inline size_t dlMapper_register(void) {
+    for (;;) {
+        const size_t epoch = atomic_load(&dlMapper_epoch);
+        atomic_fetch_add(&dlMapper_readers[epoch & 1], 1);
+        if (atomic_load(&dlMapper_epoch) == epoch) {
+            return epoch & 1;
+        }
+        // A writer advanced the epoch in the meantime and might not wait for this thread.
+        atomic_fetch_sub(&dlMapper_readers[epoch & 1], 1);
+    }
+}
+
+void dlMapper_readLock(void) {
+    if (dlMapper_reader.depth++ > 0) return;
+
+    struct dlMapper_snapshot* snapshot;
+    bool loaded;
+    do {
+        loaded = dlMapper_load(false);
+        dlMapper_reader.parity = dlMapper_register();
+        snapshot = atomic_load_explicit(&dlMapper_current, memory_order_acquire);
+        if (snapshot == NULL && loaded) {
+            // Retired in the meantime, a new one is loaded.
+            atomic_fetch_sub_explicit(&dlMapper_readers[dlMapper_reader.parity], 1, memory_order_release);
+        }
+    } while (snapshot == NULL && loaded);
+    dlMapper_reader.snapshot = snapshot;
+}
+
+void dlMapper_readUnlock(void) {
+    if (--dlMapper_reader.depth > 0) return;
+
+    dlMapper_reader.snapshot = NULL;
+    atomic_fetch_sub_explicit(&dlMapper_readers[dlMapper_reader.parity], 1, memory_order_release);
+    if (dlMapper_reader.retired != NULL) {
+        pthread_mutex_lock(&dlMapper_writeLock);
+        while (dlMapper_reader.retired != NULL) {
+            struct dlMapper_snapshot* snapshot = dlMapper_reader.retired;
+            dlMapper_reader.retired = snapshot->next;
+            dlMapper_retire(snapshot, snapshot->unloaded);
+        }
+        pthread_mutex_unlock(&dlMapper_writeLock);
+    }
+    if (dlMapper_reader.deinitPending) {
+        dlMapper_reader.deinitPending = false;
+        dlMapper_deinit();
+    }
+}
+
+struct binaryFile* dlMapper_binaryFileForAddress(const void* address, const bool includeRegions) {
+    struct dlMapper_snapshot* snapshot = dlMapper_snapshot();
+    if (snapshot == NULL) return NULL;
+
+    const struct dlMapper_segment* segment = dlMapper_snapshot_findSegment(snapshot, address);
+    if (segment == NULL ? dlMapper_platform_mightBeLoaded(address, snapshot->generation)
+                        : !dlMapper_platform_isLoaded(&snapshot->images.content[segment->image], address)) {
+        if (!dlMapper_refresh()) return NULL;
+
+        snapshot = dlMapper_snapshot();
+        segment  = dlMapper_snapshot_findSegment(snapshot, address);
+    }
+    if (segment == NULL || (segment->region && !includeRegions)) {
+        return NULL;
+    }
+    return dlMapper_image_getFile(&snapshot->images.content[segment->image]);
 }
 
 struct binaryFile* dlMapper_binaryFileForFileName(const char* fileName) {
-    if (!dlMapper_inited) return NULL;
+    struct dlMapper_snapshot* snapshot = dlMapper_snapshot();
+    if (snapshot == NULL) return NULL;
 
-    vector_iterate(&loadedLibs, {
+    vector_iterate(&snapshot->images, {
+        if (element->fileName != NULL && strcmp(fileName, element->fileName) == 0) {
+            struct binaryFile* file = dlMapper_image_getFile(element);
+            if (file != NULL) {
+                return file;
+            }
+        }
+    });
+    vector_iterate(dlMapper_snapshot_getBinaries(snapshot), {
         struct binaryFile* theElement = *element;
         if (strcmp(fileName, theElement->fileName.original) == 0
             || strcmp(fileName, theElement->fileName.absolute) == 0
@@ -146,11 +530,41 @@ void* dlMapper_absolutize(const void* address, const char* binaryName) {
 }
 
 const vector_binaryFile_t* dlMapper_getLoadedBinaries(void) {
-    return &loadedLibs;
+    struct dlMapper_snapshot* snapshot = dlMapper_snapshot();
+    return snapshot == NULL ? &dlMapper_empty : dlMapper_snapshot_getBinaries(snapshot);
+}
+
+vector_dlMapperRegion_t dlMapper_getLoadedRegions(void) {
+    vector_dlMapperRegion_t toReturn = vector_initializer;
+    struct dlMapper_snapshot* snapshot = dlMapper_snapshot();
+    if (snapshot == NULL) return toReturn;
+
+    vector_iterate(&snapshot->segments, {
+        if (element->writable) {
+            struct binaryFile* file = dlMapper_image_getFile(&snapshot->images.content[element->image]);
+            if (file != NULL) {
+                vector_push_back(&toReturn, ((struct dlMapper_region) {
+                    (uintptr_t) element->start, (uintptr_t) element->end, file
+                }));
+            }
+        }
+    });
+    return toReturn;
 }
 
 void dlMapper_deinit(void) {
-    vector_destroyWith(&loadedLibs, binaryFile_delete);
-    vector_init(&loadedLibs);
-    dlMapper_inited = false;
+    if (dlMapper_reader.depth > 0) {
+        dlMapper_reader.deinitPending = true;
+        return;
+    }
+
+    pthread_mutex_lock(&dlMapper_writeLock);
+    struct dlMapper_snapshot* snapshot = atomic_exchange(&dlMapper_current, NULL);
+    dlMapper_synchronize();
+    if (snapshot != NULL) {
+        dlMapper_snapshot_delete(snapshot);
+    }
+    binaryFile_clearCaches();
+    unwinder_cfi_invalidateCache();
+    pthread_mutex_unlock(&dlMapper_writeLock);
 }
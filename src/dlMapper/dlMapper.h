@@ -31,11 +31,29 @@
 typedef_vector_named(binaryFile, struct binaryFile*);
 typedef_pair_named(relativeFile, struct binaryFile*, uintptr_t);
 
+/**
+ * A writable region of a loaded runtime image.
+ */
+struct dlMapper_region {
+    /** The start address of the region.                                  */
+    uintptr_t start;
+    /** The end address of the region.                                    */
+    uintptr_t end;
+    /** The loaded library info of the runtime image containing the region. */
+    struct binaryFile* file;
+};
+
+typedef_vector_named(dlMapperRegion, struct dlMapper_region);
+
 /**
  * @brief Initializes the dlMapper.
  *
- * Does nothing if it has already been initialized; if that is the case,
- * @c true will be returned.
+ * Does nothing if it has already been initialized and no runtime images have
+ * been loaded or unloaded since; if that is the case, @c true will be
+ * returned. Otherwise, the loaded runtime image infos are refreshed, taking
+ * over the library infos of the runtime images that are still loaded. This
+ * check might take the lock of the dynamic loader.<br>
+ * Inside of a read section only the snapshot pinned by it is considered.
  *
  * @return whether the dlMapper has been successfully initialized
  */
@@ -49,7 +67,39 @@ bool dlMapper_init(void);
 bool dlMapper_isInited(void);
 
 /**
- * Returns the loaded library info the given pointer is associated with.
+ * @brief Enters a read section, initializing the dlMapper if necessary.
+ *
+ * The loaded runtime image infos are published as immutable snapshots. Inside
+ * of a read section the current snapshot is pinned: The runtime image infos
+ * returned by the dlMapper stay valid until the read section is left, even if
+ * the dlMapper is deinitialized by another thread in the meantime. Entering
+ * and leaving a read section does not take any lock once a snapshot is
+ * published: The loaded runtime images are not checked when entering, instead
+ * a lookup missing the pinned snapshot where a runtime image might have been
+ * loaded since or hitting a runtime image known to be unloaded refreshes it. Where unloading cannot be detected without a lock,
+ * unloaded runtime images are only dropped by such a refresh or by calling
+ * dlMapper_init() outside of a read section.<br>
+ * Read sections can be nested.
+ */
+void dlMapper_readLock(void);
+
+/**
+ * @brief Leaves the read section of the calling thread.
+ *
+ * If the dlMapper was deinitialized by the calling thread inside of the read
+ * section, the deinitialization is executed when the outermost read section
+ * is left.
+ */
+void dlMapper_readUnlock(void);
+
+/**
+ * @brief Returns the loaded library info the given pointer is associated with.
+ *
+ * The loaded library info is created on the first lookup of an address
+ * inside of its runtime image. If the address is not found in the used
+ * snapshot of the loaded runtime images, the snapshot is only refreshed if the
+ * platform cannot rule out a newly loaded runtime image at the address without
+ * taking any lock.
  *
  * @param address the address whose runtime image to find
  * @param includeRegions whether to search within all regions found in the binary files
@@ -85,14 +135,34 @@ pair_relativeFile_t dlMapper_relativize(const void* address);
 void* dlMapper_absolutize(const void* address, const char* binaryName);
 
 /**
- * Returns the loaded runtime image infos.
+ * @brief Returns the loaded runtime image infos.
+ *
+ * The runtime image infos not yet needed by a lookup are created first. The
+ * returned vector is only guaranteed to stay valid inside of a read section.
  *
  * @return the loaded runtime image infos
  */
 const vector_binaryFile_t* dlMapper_getLoadedBinaries(void);
 
 /**
- * Deinitializes the dlMapper.
+ * @brief Returns the writable regions of the loaded runtime images, sorted by
+ * their start address.
+ *
+ * The regions are taken from the loaded segments of the runtime images; the
+ * runtime images are not parsed. The referenced runtime image infos are only
+ * guaranteed to stay valid inside of a read section.
+ *
+ * @return the writable regions, to be destroyed by the caller
+ */
+vector_dlMapperRegion_t dlMapper_getLoadedRegions(void);
+
+/**
+ * @brief Deinitializes the dlMapper.
+ *
+ * The current snapshot is retired and deleted once all readers that might use
+ * it have left their read section; the caches of the binary files are cleared
+ * afterwards. If called inside of a read section, the deinitialization is
+ * deferred until the outermost read section of the calling thread is left.
  */
 void dlMapper_deinit(void);
 
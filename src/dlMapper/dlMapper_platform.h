@@ -25,12 +25,105 @@
 #include "dlMapper.h"
 
 /**
- * Loads the loaded runtime images into the given loaded library information vector.
+ * @brief A loaded runtime image.
  *
- * @param libs the loaded library information vector
+ * Its binary file abstraction is only created once an address inside of it is
+ * looked up.
+ */
+struct dlMapper_image {
+    /** The start address of the runtime image.                          */
+    const void* start;
+    /** The offset the runtime image has been relocated by.              */
+    uintptr_t relocationOffset;
+    /** The raw file name of the runtime image.                          */
+    char* fileName;
+    /** The thread-local storage of the runtime image.                   */
+    struct binaryFile_tls tls;
+    /** The binary file abstraction or @c NULL if not yet created.       */
+    struct binaryFile* _Atomic file;
+};
+
+typedef_vector_named(dlMapperImage, struct dlMapper_image);
+
+/**
+ * A loaded segment of a runtime image.
+ */
+struct dlMapper_segment {
+    /** The start address of the segment.                                    */
+    const void* start;
+    /** The end address of the segment.                                      */
+    const void* end;
+    /** The index of the runtime image the segment belongs to.               */
+    size_t image;
+    /** Whether the segment is only considered when looking up the regions.  */
+    bool region;
+    /** Whether the segment is writable.                                     */
+    bool writable;
+};
+
+typedef_vector_named(dlMapperSegment, struct dlMapper_segment);
+
+/**
+ * @brief Loads the loaded runtime images and their segments into the given
+ * vectors.
+ *
+ * Only the segments and the names of the runtime images are loaded, unless
+ * the platform needs to create the binary file abstractions for deducting the
+ * segments.
+ *
+ * @param images the vector to be filled with the loaded runtime images
+ * @param segments the vector to be filled with the loaded segments of the runtime images
+ * @param generation the generation of the loaded runtime images to be filled
  * @return whether the information could be loaded successfully
  */
-bool dlMapper_platform_loadLoadedLibraries(vector_binaryFile_t* libs);
+bool dlMapper_platform_loadLoadedLibraries(vector_dlMapperImage_t* images, vector_dlMapperSegment_t* segments,
+                                           uint64_t* generation);
+
+/**
+ * @brief Returns the generation of the loaded runtime images.
+ *
+ * The generation changes whenever a runtime image is loaded or unloaded.
+ * Might take the lock of the dynamic loader.
+ *
+ * @return the current generation
+ */
+uint64_t dlMapper_platform_loadGeneration(void);
+
+/**
+ * @brief Returns whether runtime images are known to have been loaded or
+ * unloaded since the given generation.
+ *
+ * Does not take any lock; if that is not possible, @c false is returned.
+ *
+ * @param generation the generation of the loaded runtime images
+ * @return whether the given generation is known to be outdated
+ */
+bool dlMapper_platform_isOutdated(uint64_t generation);
+
+/**
+ * @brief Returns whether the given runtime image is still loaded at the given
+ * address inside of it.
+ *
+ * Does not take any lock; if that is not possible, @c true is returned.
+ *
+ * @param image the runtime image
+ * @param address the looked up address inside of the runtime image
+ * @return whether the runtime image is not known to be unloaded
+ */
+bool dlMapper_platform_isLoaded(const struct dlMapper_image* image, const void* address);
+
+/**
+ * @brief Returns whether a runtime image unknown to the given generation might
+ * be loaded at the given address.
+ *
+ * Does not take any lock. Called when a lookup missed, a snapshot is only
+ * refreshed if @c true is returned.
+ *
+ * @param address the looked up address
+ * @param generation the generation of the snapshot the lookup missed
+ * @return whether refreshing the snapshot might find the address
+ */
+bool dlMapper_platform_mightBeLoaded(const void* address, uint64_t generation);
 
 /**
  * @brief Relativizes the given address to the given runtime image info.
@@ -21,11 +21,14 @@
 
 #include <elf.h>
 #include <limits.h>
+#include <pthread.h>
+#include <stddef.h>
 #include <string.h>
 #include <unistd.h>
 
 #define _GNU_SOURCE
 # define __USE_GNU
+#  include <dlfcn.h>
 #  include <link.h>
 # undef __USE_GNU
 #undef _GNU_SOURCE
@@ -33,16 +36,32 @@
 #include "../dlMapper_platform.h"
 
 /**
- * This structure is used to pass the address of our runtime image and
- * the loaded library information vector to the iteration callback.
+ * This structure is used to pass the loaded runtime image and segment vectors
+ * and the generation to be filled to the iteration callback.
  */
 struct dlMapper_platform_data {
-    /** The pointer into our runtime image.    */
-    const void* inside;
-    /** The loaded library information vector. */
-    vector_binaryFile_t* libs;
+    /** The loaded runtime image vector.      */
+    vector_dlMapperImage_t* images;
+    /** The loaded segment vector.            */
+    vector_dlMapperSegment_t* segments;
+    /** The generation of the loaded images.  */
+    uint64_t generation;
 };
 
+/**
+ * Returns the generation of the loaded runtime images given by the system.
+ *
+ * @param info the system info
+ * @param size the size of the passed info structure
+ * @return the count of loaded and unloaded runtime images or @c 0 if not supported
+ */
+static inline uint64_t dlMapper_platform_generationOf(const struct dl_phdr_info* info, const size_t size) {
+    if (size < offsetof(struct dl_phdr_info, dlpi_subs) + sizeof(info->dlpi_subs)) {
+        return 0;
+    }
+    return info->dlpi_adds + info->dlpi_subs;
+}
+
 /**
  * Loads the file name of the main executable.
  *
@@ -63,23 +82,68 @@ static inline char* dlMapper_platform_loadExecutableName(void) {
 }
 
 /**
- * Loads the address the given runtime image can be found at.
+ * @brief Stores the loaded segments of the given runtime image into the given
+ * vector.
+ *
+ * The @c PT_GNU_RELRO segment is not stored separately: It is part of a
+ * writable segment, since it is only made read-only after the relocation.
  *
  * @param info the runtime image info
- * @return the address the runtime image starts at
+ * @param segments the vector of the loaded segments
+ * @param image the index of the runtime image
  */
-static inline void* dlMapper_platform_loadELFLoadedAddress(const struct dl_phdr_info* info) {
+static inline void dlMapper_platform_pushSegments(const struct dl_phdr_info* info, vector_dlMapperSegment_t* segments,
+                                                  const size_t image) {
     for (unsigned i = 0; i < info->dlpi_phnum; ++i) {
-        if (info->dlpi_phdr[i].p_type == PT_LOAD) {
-            return (void*) info->dlpi_addr + info->dlpi_phdr[i].p_vaddr;
+        if (info->dlpi_phdr[i].p_type != PT_LOAD || info->dlpi_phdr[i].p_memsz == 0) continue;
+
+        const void* begin = (void*) info->dlpi_addr + info->dlpi_phdr[i].p_vaddr;
+        vector_push_back(segments, ((struct dlMapper_segment) {
+            .start    = begin,
+            .end      = begin + info->dlpi_phdr[i].p_memsz,
+            .image    = image,
+            .region   = false,
+            .writable = (info->dlpi_phdr[i].p_flags & PF_W) != 0,
+        }));
+    }
+}
+
+/**
+ * Returns the start address of the lowest loaded segment of the given runtime image.
+ *
+ * @param info the runtime image info
+ * @return the start address or @c NULL if the runtime image has no loaded segment
+ */
+static inline const void* dlMapper_platform_loadELFStart(const struct dl_phdr_info* info) {
+    const void* start = NULL;
+    for (unsigned i = 0; i < info->dlpi_phnum; ++i) {
+        if (info->dlpi_phdr[i].p_type != PT_LOAD) continue;
+
+        const void* begin = (void*) info->dlpi_addr + info->dlpi_phdr[i].p_vaddr;
+        if (start == NULL || begin < start) {
+            start = begin;
         }
     }
-    return NULL;
+    return start;
+}
+
+/**
+ * Returns the thread-local storage of the given runtime image.
+ *
+ * @param info the runtime image info
+ * @param size the size of the passed info structure
+ * @return the thread-local storage as reported to the calling thread
+ */
+static inline struct binaryFile_tls dlMapper_platform_loadTLS(const struct dl_phdr_info* info, const size_t size) {
+    if (size < offsetof(struct dl_phdr_info, dlpi_tls_data) + sizeof(info->dlpi_tls_data)) {
+        return (struct binaryFile_tls) { 0, NULL, (pthread_t) 0 };
+    }
+    return (struct binaryFile_tls) { info->dlpi_tls_modid, info->dlpi_tls_data, pthread_self() };
 }
 
 /**
- * Creates a loaded library information from the given info and stores it in
- * the given payload.
+ * Records the runtime image of the given info and the generation in the
+ * given payload.
  *
  * @param info the system info
  * @param size the size of the passed info structure
@@ -87,52 +151,122 @@ static inline void* dlMapper_platform_loadELFLoadedAddress(const struct dl_phdr_
  * @return whether to continue iterating
  */
 static inline int dlMapper_platform_iterateCallback(struct dl_phdr_info* info, const size_t size, void* d) {
-    (void) size;
-
     struct dlMapper_platform_data* data = d;
+    data->generation = dlMapper_platform_generationOf(info, size);
 
-    const char* fileName = info->dlpi_name;
-    bool empty = *fileName == '\0';
-    if (empty) {
-        const char* newFileName = dlMapper_platform_loadExecutableName();
-        if (newFileName != NULL) {
-            fileName = newFileName;
-        } else {
-            empty = false;
-        }
+    struct dlMapper_image image = {
+        .start            = dlMapper_platform_loadELFStart(info),
+        .relocationOffset = info->dlpi_addr,
+        .tls              = dlMapper_platform_loadTLS(info, size),
+        .file             = NULL,
+    };
+    if (image.start == NULL) {
+        return 0;
     }
-    const void* loadedAddress = dlMapper_platform_loadELFLoadedAddress(info);
-    if (loadedAddress != NULL) {
-        struct binaryFile* file = binaryFile_new(fileName, loadedAddress);
-        if (file != NULL) {
-            file->relocationOffset = info->dlpi_addr;
-            vector_push_back(data->libs, file);
-        }
+    image.fileName = *info->dlpi_name == '\0' ? dlMapper_platform_loadExecutableName() : NULL;
+    if (image.fileName == NULL) {
+        image.fileName = strdup(info->dlpi_name);
     }
-    if (empty) {
-        free((void*) fileName);
+    if (image.fileName == NULL) {
+        return 0;
     }
+    if (!vector_push_back(data->images, image)) {
+        free(image.fileName);
+        return 0;
+    }
+    dlMapper_platform_pushSegments(info, data->segments, data->images->count - 1);
     return 0;
 }
 
+bool dlMapper_platform_loadLoadedLibraries(vector_dlMapperImage_t* images, vector_dlMapperSegment_t* segments,
+                                           uint64_t* generation) {
+    struct dlMapper_platform_data data = { images, segments, 0 };
+    const bool result = dl_iterate_phdr(dlMapper_platform_iterateCallback, &data) == 0;
+    *generation = data.generation;
+    return result;
+}
+
+#ifndef DLFO_STRUCT_HAS_EH_DBASE
+/** The count of missed pages remembered per thread; has to be a power of two. */
+# define DLMAPPER_PLATFORM_MISSES 8
+
 /**
- * Loads an address pointing into our runtime image.
+ * The pages of the addresses the lookups of a thread have missed.
+ */
+struct dlMapper_platform_misses {
+    /** The generation the misses happened in.   */
+    uint64_t generation;
+    /** The missed pages, shifted by one.        */
+    uintptr_t pages[DLMAPPER_PLATFORM_MISSES];
+    /** The index of the next page to be stored. */
+    size_t next;
+};
+
+/** The misses of the calling thread. */
+static _Thread_local struct dlMapper_platform_misses dlMapper_platform_misses;
+#endif
+
+/**
+ * Stores the generation of the loaded runtime images and stops the iteration.
  *
- * @return a pointer into our runtime image
+ * @param info the system info
+ * @param size the size of the passed info structure
+ * @param d the generation to be filled
+ * @return @c 1 to stop the iteration
  */
-static inline void* dlMapper_platform_loadLCSAddress(void) {
-    volatile void* me = NULL;
-    me = &dlMapper_platform_loadLCSAddress;
-    return (void*) me;
+static int dlMapper_platform_generationCallback(struct dl_phdr_info* info, const size_t size, void* d) {
+    *(uint64_t*) d = dlMapper_platform_generationOf(info, size);
+    return 1;
 }
 
-bool dlMapper_platform_loadLoadedLibraries(vector_binaryFile_t* libs) {
-    struct dlMapper_platform_data data = (struct dlMapper_platform_data) {
-        dlMapper_platform_loadLCSAddress(),
-        libs
-    };
+uint64_t dlMapper_platform_loadGeneration(void) {
+    uint64_t generation = 0;
+    dl_iterate_phdr(dlMapper_platform_generationCallback, &generation);
+    return generation;
+}
+
+bool dlMapper_platform_isOutdated(const uint64_t generation) {
+    (void) generation;
 
-    return dl_iterate_phdr(dlMapper_platform_iterateCallback, &data) == 0;
+    // The generation is only available while holding the lock of the dynamic loader.
+    return false;
+}
+
+bool dlMapper_platform_isLoaded(const struct dlMapper_image* image, const void* address) {
+#ifdef DLFO_STRUCT_HAS_EH_DBASE
+    struct dl_find_object object;
+    if (_dl_find_object((void*) address, &object) != 0) {
+        return false;
+    }
+    return object.dlfo_link_map->l_addr == image->relocationOffset
+        && image->start >= object.dlfo_map_start && image->start < object.dlfo_map_end;
+#else
+    (void) image;
+    (void) address;
+
+    return true;
+#endif
+}
+
+bool dlMapper_platform_mightBeLoaded(const void* address, const uint64_t generation) {
+#ifdef DLFO_STRUCT_HAS_EH_DBASE
+    (void) generation;
+
+    struct dl_find_object object;
+    return _dl_find_object((void*) address, &object) == 0;
+#else
+    // Without a lock-free lookup, each missed page only refreshes the snapshot once per generation.
+    struct dlMapper_platform_misses* misses = &dlMapper_platform_misses;
+    if (misses->generation != generation) {
+        *misses = (struct dlMapper_platform_misses) { .generation = generation };
+    }
+    const uintptr_t page = ((uintptr_t) address >> 12) + 1;
+    for (size_t i = 0; i < DLMAPPER_PLATFORM_MISSES; ++i) {
+        if (misses->pages[i] == page) return false;
+    }
+    misses->pages[misses->next++ & (DLMAPPER_PLATFORM_MISSES - 1)] = page;
+    return true;
+#endif
 }
 
 uintptr_t dlMapper_platform_relativize(const struct binaryFile* info, const void* address) {
@@ -19,38 +19,159 @@
  * CallstackLibrary, see the file LICENSE.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <pthread.h>
+#include <stdatomic.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <mach-o/dyld.h>
 #include <mach-o/dyld_images.h>
+#include <mach-o/loader.h>
 
 #include "../dlMapper_platform.h"
 
+#ifdef __LP64__
+typedef struct mach_header_64     dlMapper_platform_header;
+typedef struct segment_command_64 dlMapper_platform_segment;
+# define DLMAPPER_PLATFORM_LC_SEGMENT LC_SEGMENT_64
+#else
+typedef struct mach_header        dlMapper_platform_header;
+typedef struct segment_command    dlMapper_platform_segment;
+# define DLMAPPER_PLATFORM_LC_SEGMENT LC_SEGMENT
+#endif
+
+/** The count of runtime images loaded and unloaded since the registration. */
+static _Atomic uint64_t dlMapper_platform_generation = 0;
+/** Guards the registration of the image callbacks.                         */
+static pthread_once_t dlMapper_platform_registration = PTHREAD_ONCE_INIT;
+
+/**
+ * Advances the generation of the loaded runtime images.
+ *
+ * @param header the loaded or unloaded runtime image
+ * @param slide the slide of the runtime image
+ */
+static void dlMapper_platform_imageCallback(const struct mach_header* header, const intptr_t slide) {
+    (void) header;
+    (void) slide;
+
+    atomic_fetch_add_explicit(&dlMapper_platform_generation, 1, memory_order_release);
+}
+
+/**
+ * Registers the image callbacks advancing the generation.
+ */
+static void dlMapper_platform_register(void) {
+    _dyld_register_func_for_add_image(dlMapper_platform_imageCallback);
+    _dyld_register_func_for_remove_image(dlMapper_platform_imageCallback);
+}
+
+uint64_t dlMapper_platform_loadGeneration(void) {
+    pthread_once(&dlMapper_platform_registration, dlMapper_platform_register);
+    return atomic_load_explicit(&dlMapper_platform_generation, memory_order_acquire);
+}
+
+bool dlMapper_platform_isOutdated(const uint64_t generation) {
+    return generation != dlMapper_platform_loadGeneration();
+}
+
+bool dlMapper_platform_isLoaded(const struct dlMapper_image* image, const void* address) {
+    (void) image;
+    (void) address;
+
+    // Unloading advances the generation, which is checked when entering a read section.
+    return true;
+}
+
+bool dlMapper_platform_mightBeLoaded(const void* address, const uint64_t generation) {
+    (void) address;
+
+    return dlMapper_platform_isOutdated(generation);
+}
+
 /**
- * Efficiently checks the given object expression whether it is @c NULL , if it
- * is not, the given expression is executed.
+ * @brief Stores the loaded segments of the given runtime image into the given
+ * vector.
+ *
+ * The @c __TEXT segment makes up the runtime image, the readable and writable
+ * segments are stored as its regions.
  *
- * @param theObject the object to be checked
- * @param expr the expression to be executed if the given object is not @c NULL
+ * @param segments the vector of the loaded segments
+ * @param image the index of the runtime image
+ * @param file the binary file abstraction of the runtime image
  */
-#define dlMapper_safe(theObject, expr)  \
-typeof(theObject) object = (theObject); \
-if (object != NULL) {                   \
-    expr;                               \
+static inline void dlMapper_platform_pushSegments(vector_dlMapperSegment_t* segments, const size_t image,
+                                                  const struct binaryFile* file) {
+    const dlMapper_platform_header* header = file->startAddress;
+    const uintptr_t slide = (uintptr_t) file->startAddress - file->relocationOffset;
+
+    const struct load_command* command = (const void*) (header + 1);
+    for (uint32_t i = 0; i < header->ncmds; ++i) {
+        if (command->cmd == DLMAPPER_PLATFORM_LC_SEGMENT) {
+            const dlMapper_platform_segment* segment = (const void*) command;
+            const bool text = strcmp(segment->segname, SEG_TEXT) == 0;
+            if (text || (segment->initprot & VM_PROT_READ && segment->initprot & VM_PROT_WRITE)) {
+                vector_push_back(segments, ((struct dlMapper_segment) {
+                    .start    = (const void*) (slide + segment->vmaddr),
+                    .end      = (const void*) (slide + segment->vmaddr + segment->vmsize),
+                    .image    = image,
+                    .region   = !text,
+                    .writable = !text,
+                }));
+            }
+        }
+        command = (const void*) command + command->cmdsize;
+    }
+}
+
+/**
+ * @brief Creates the binary file abstraction of the given runtime image and
+ * stores it in the given vector.
+ *
+ * The relocation offset of a Mach-O runtime image is only known after parsing
+ * its load commands, the binary file abstraction is therefore created
+ * directly.
+ *
+ * @param images the vector of the loaded runtime images
+ * @param segments the vector of the loaded segments
+ * @param fileName the file name of the runtime image
+ * @param header the start address of the runtime image
+ */
+static inline void dlMapper_platform_pushImage(vector_dlMapperImage_t* images, vector_dlMapperSegment_t* segments,
+                                               const char* fileName, const void* header) {
+    struct binaryFile* file = binaryFile_new(fileName, header);
+    if (file == NULL) return;
+
+    char* name = strdup(fileName);
+    const bool pushed = name != NULL && vector_push_back(images, ((struct dlMapper_image) {
+        .start            = file->startAddress,
+        .relocationOffset = file->relocationOffset,
+        .fileName         = name,
+        .tls              = { 0, NULL, (pthread_t) 0 },
+        .file             = file,
+    }));
+    if (!pushed) {
+        free(name);
+        binaryFile_release(file);
+        return;
+    }
+    dlMapper_platform_pushSegments(segments, images->count - 1, file);
 }
 
-bool dlMapper_platform_loadLoadedLibraries(vector_binaryFile_t* libs) {
+bool dlMapper_platform_loadLoadedLibraries(vector_dlMapperImage_t* images, vector_dlMapperSegment_t* segments,
+                                           uint64_t* generation) {
+    *generation = dlMapper_platform_loadGeneration();
     const uint32_t count = _dyld_image_count();
-    vector_reserve(libs, count + 1);
+    vector_reserve(images, count + 1);
     for (uint32_t i = 0; i < count; ++i) {
-        dlMapper_safe(binaryFile_new(_dyld_get_image_name(i),
-            _dyld_get_image_header(i)), vector_push_back(libs, object))
+        dlMapper_platform_pushImage(images, segments, _dyld_get_image_name(i), _dyld_get_image_header(i));
     }
 
     struct task_dyld_info dyldInfo;
     mach_msg_type_number_t infoCount = TASK_DYLD_INFO_COUNT;
     if (task_info(mach_task_self_, TASK_DYLD_INFO, (task_info_t) &dyldInfo, &infoCount) == KERN_SUCCESS) {
         const struct dyld_all_image_infos* infos = (void*) dyldInfo.all_image_info_addr;
-        dlMapper_safe(binaryFile_new(infos->dyldPath, infos->dyldImageLoadAddress), vector_push_back(libs, object))
+        dlMapper_platform_pushImage(images, segments, infos->dyldPath, infos->dyldImageLoadAddress);
     } else {
         printf("LCS: Warning: Failed to load the dynamic loader. Callstacks might be truncated.\n");
     }
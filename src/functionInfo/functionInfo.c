@@ -45,8 +45,9 @@ static inline bool functionInfo_getFrom(struct binaryFile*   info,
 struct functionInfo functionInfo_loadHint(const char* functionName, const char* libraryName) {
     struct functionInfo toReturn = (struct functionInfo) { 0, 0, false };
 
-    dlMapper_init();
+    dlMapper_readLock();
     if (libraryName != NULL && functionInfo_getFrom(dlMapper_binaryFileForFileName(libraryName), functionName, &toReturn)) {
+        dlMapper_readUnlock();
         maybeV(callstack_clearCaches);
         return toReturn;
     }
@@ -56,6 +57,7 @@ struct functionInfo functionInfo_loadHint(const char* functionName, const char*
             break;
         }
     });
+    dlMapper_readUnlock();
     maybeV(callstack_clearCaches);
     return toReturn;
 }
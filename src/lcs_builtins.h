@@ -1,7 +1,7 @@
 /*
  * CallstackLibrary - Library creating human-readable call stacks.
  *
- * Copyright (C) 2024  mhahnFr
+ * Copyright (C) 2024, 2026  mhahnFr
  *
  * This file is part of the CallstackLibrary.
  *
@@ -28,10 +28,12 @@ extern "C" {
 
 #ifdef LCS_USE_BUILTINS
  #define lcs_returnAddress(level) (__builtin_return_address(level))
+ #define lcs_frameAddress(level)  (__builtin_frame_address(level))
 #else
  #include <stddef.h>
 
  #define lcs_returnAddress(level) (NULL)
+ #define lcs_frameAddress(level)  (NULL)
 #endif
 
 #ifdef __cplusplus
@@ -23,37 +23,12 @@
 
 #include <inttypes.h>
 
-#include "../callstackInternal.h"
 #include "../dlMapper/dlMapper_platform.h"
 #include "demangling/demangler.h"
 #include "file/binaryFile.h"
-#include "lcs_stdio.h"
+#include "../callstackFrame/callstackFrameArena.h"
 
-/**
- * Translates the given callstack using the given parser.
- *
- * @param self the callstack parser to be used
- * @param callstack the callstack to be translated
- * @return whether the translation was successful
- */
-static inline bool callstack_parser_parseImpl(const struct callstack_parser* self,
-                                              const struct callstack*        callstack) {
-    (void) self;
-
-    size_t failed = 0;
-    for (size_t i = 0; i < callstack->backtraceSize; ++i) {
-        struct binaryFile* file = callstack->frames[i].reserved;
-        if (file == NULL) {
-            continue;
-        }
-        if (!binaryFile_addr2String(file, callstack->backtrace[i], &callstack->frames[i])) {
-            callstack->frames[i].reserved2 = false;
-            asprintf(&callstack->frames[i].function, "0x%" PRIxPTR, dlMapper_platform_relativize(file, callstack->backtrace[i]));
-            ++failed;
-        }
-    }
-    return failed != callstack->backtraceSize;
-}
+_Thread_local size_t callstack_parser_alive = 0;
 
 char* callstack_parser_demangleCopy(char* name, const bool copy) {
     char* result   = name;
@@ -67,12 +42,21 @@ char* callstack_parser_demangleCopy(char* name, const bool copy) {
     return needsCopy ? (copy ? strdup(result) : NULL) : result;
 }
 
-enum callstack_type callstack_parser_parse(const struct callstack_parser* self,
-                                           struct callstack* callstack) {
-    if (!callstack_parser_parseImpl(self, callstack)) {
-        callstack_reset(callstack);
-        return FAILED;
+bool callstack_parser_parseFrames(const struct callstack_parser* self, void* const backtrace[],
+                                  struct callstack_frame frames[], const size_t count) {
+    (void) self;
+
+    size_t failed = 0;
+    for (size_t i = 0; i < count; ++i) {
+        struct binaryFile* file = frames[i].reserved;
+        if (file == NULL || frames[i].function != NULL) {
+            continue;
+        }
+        if (!binaryFile_addr2String(file, backtrace[i], &frames[i])) {
+            frames[i].reserved2 = false;
+            frames[i].function = callstackFrameArena_format("0x%" PRIxPTR, dlMapper_platform_relativize(file, backtrace[i]));
+            ++failed;
+        }
     }
-    
-    return TRANSLATED;
+    return failed != count;
 }
@@ -25,6 +25,8 @@
 #include <callstack.h>
 #include <callstack_internals.h>
 
+#include "../dlMapper/dlMapper.h"
+
 /**
  * The structure of a callstack parser.
  */
@@ -33,14 +35,33 @@ struct callstack_parser {
     bool clearCaches;
 };
 
+/** The count of the callstack parsers alive on the calling thread. */
+extern _Thread_local size_t callstack_parser_alive;
+
 /**
- * Constructs the given callstack parser object.
+ * @brief Returns whether the caches should be cleared automatically by the
+ * calling thread.
+ *
+ * While a callstack parser is alive on the calling thread, the caches are
+ * only cleared by it.
+ *
+ * @return whether to clear the caches automatically
+ */
+static inline bool callstack_parser_clearsCaches(void) {
+    return callstack_autoClearCaches && callstack_parser_alive == 0;
+}
+
+/**
+ * @brief Constructs the given callstack parser object.
+ *
+ * The loaded runtime images are pinned for the lifetime of the parser.
  *
  * @param self The callstack parser object to construct.
  */
 static inline void callstack_parser_create(struct callstack_parser* self) {
-    self->clearCaches = callstack_autoClearCaches;
-    callstack_autoClearCaches = false;
+    self->clearCaches = callstack_parser_clearsCaches();
+    ++callstack_parser_alive;
+    dlMapper_readLock();
 }
 
 /**
@@ -49,25 +70,27 @@ static inline void callstack_parser_create(struct callstack_parser* self) {
  * @param self The callstack parser object to destroy.
  */
 static inline void callstack_parser_destroy(const struct callstack_parser* self) {
+    dlMapper_readUnlock();
+    --callstack_parser_alive;
     if (self->clearCaches) {
         callstack_clearCaches();
     }
-    callstack_autoClearCaches = self->clearCaches;
 }
 
 /**
- * @brief Parses the debug symbols to create a human-readable callstack.
+ * @brief Translates the given callstack frames using the given parser.
  *
- * Tries to parse the debug symbols, if they are not available, the information of the
- * dynamic linker is used to translate the callstack.
- * If any error occurs, FAILED is returned.
+ * The binary files of the given frames need to be deducted already. Frames
+ * whose binary file is not known and frames already translated are skipped.
  *
- * @param self The callstack parser object.
- * @param callstack The callstack to parse the symbols for.
- * @return The type of the used symbols.
+ * @param self the callstack parser object
+ * @param backtrace the addresses of the frames
+ * @param frames the callstack frames to be translated
+ * @param count the count of frames
+ * @return whether at least one frame could be translated
  */
-enum callstack_type callstack_parser_parse(const struct callstack_parser* self,
-                                           struct callstack* callstack);
+bool callstack_parser_parseFrames(const struct callstack_parser* self, void* const backtrace[],
+                                  struct callstack_frame frames[], size_t count);
 
 /**
  * @brief Demangles the given name if possible and enabled.
@@ -19,13 +19,21 @@
  * CallstackLibrary, see the file LICENSE.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#ifdef __linux__
+# define _GNU_SOURCE
+#endif
+
 #include "binaryFile.h"
 
+#include <dlfcn.h>
 #include <try_catch.h>
 #include <file/pathUtils.h>
 #include <sys/stat.h>
 
+#include "debugInfoCache.h"
 #include "exception.h"
+#include "../callstack_parser.h"
+#include "../../callstackFrame/callstackFrameArena.h"
 
 #ifdef __APPLE__
 # include "macho/machoFile.h"
@@ -64,7 +72,7 @@ struct binaryFile* binaryFile_new(const char* fileName, const void* startAddress
     }
     struct binaryFile* toReturn = &tmp->_;
     *toReturn = (struct binaryFile) {
-        false,
+        BINARY_FILE_UNPARSED,
         true,
         false,
         {
@@ -75,7 +83,12 @@ struct binaryFile* binaryFile_new(const char* fileName, const void* startAddress
         startAddress,
         NULL,
         0,
+        { 0, NULL, (pthread_t) 0 },
         vector_initializer,
+        PTHREAD_MUTEX_INITIALIZER,
+        PTHREAD_COND_INITIALIZER,
+        (pthread_t) 0,
+        1,
     };
     LCS_FILE(tmp, create);
     struct binaryFile* const volatile captureToReturn = toReturn;
@@ -92,10 +105,56 @@ struct binaryFile* binaryFile_new(const char* fileName, const void* startAddress
     return toReturn;
 }
 
+/**
+ * @brief Stores the exported symbol of the given address into the given
+ * callstack frame.
+ *
+ * The symbol is looked up by the dynamic linker, which does not need the
+ * binary file to be parsed.
+ *
+ * @param self the binary file
+ * @param address the address to be translated
+ * @param frame the callstack frame to be filled
+ * @return whether a symbol was found
+ */
+static inline bool binaryFile_addr2SymbolOnly(const struct binaryFile* self, const void* address,
+                                              struct callstack_frame* frame) {
+    Dl_info info;
+    if (!self->inMemory || dladdr(address, &info) == 0 || info.dli_sname == NULL || info.dli_saddr == NULL) {
+        return false;
+    }
+
+    char* demangled = callstack_rawNames ? NULL : callstack_parser_demangleCopy((char*) info.dli_sname, false);
+    const char* name = demangled == NULL ? info.dli_sname : demangled;
+    const ptrdiff_t diff = (ptrdiff_t) (address - info.dli_saddr);
+    if (diff > 0) {
+        frame->function = callstackFrameArena_format("%s + %td", name, diff);
+    } else {
+        frame->function = callstackFrameArena_copy(name);
+    }
+    free(demangled);
+    frame->reserved2 = false;
+    return frame->function != NULL;
+}
+
 bool binaryFile_addr2String(struct binaryFile* self, const void* address, struct callstack_frame* frame) {
+    if (!binaryFile_maybeParse(self)) {
+        return binaryFile_addr2SymbolOnly(self, address, frame);
+    }
     return LCS_FILE(self, addr2String, address, frame);
 }
 
+void binaryFile_addr2StringSorted(struct binaryFile* self, void* const addresses[], struct callstack_frame frames[],
+                                  const size_t count) {
+    if (!binaryFile_maybeParse(self)) {
+        for (size_t i = 0; i < count; ++i) {
+            binaryFile_addr2SymbolOnly(self, addresses[i], &frames[i]);
+        }
+        return;
+    }
+    LCS_FILE(self, addr2StringSorted, addresses, frames, count);
+}
+
 bool binaryFile_getFunctionInfo(struct binaryFile* self, const char* functionName, struct functionInfo* info) {
     return LCS_FILE(self, getFunctionInfo, functionName, info);
 }
@@ -127,24 +186,60 @@ void binaryFile_sortRegions(struct binaryFile* self) {
     vector_sort(&self->regions, binaryFile_regionsCompare);
 }
 
-vector_pair_ptr_t binaryFile_getTLSRegions(struct binaryFile* self) {
-    return LCS_FILE(self, getTLSRegions);
+vector_pair_ptr_t binaryFile_getTLSRegions(struct binaryFile* self, const pthread_t thread) {
+    return LCS_FILE(self, getTLSRegions, thread);
+}
+
+/**
+ * @brief Parses the given binary file and publishes the result.
+ *
+ * The parsing is done without holding the lock of the binary file, the
+ * waiting threads are woken up afterwards.
+ *
+ * @param self the binary file to be parsed, claimed by the calling thread
+ */
+static inline void binaryFile_parse(struct binaryFile* self) {
+    pthread_mutex_unlock(&self->lock);
+    TRY({
+        LCS_FILE(self, parse);
+        pthread_mutex_lock(&self->lock);
+        __atomic_store_n(&self->parseState, BINARY_FILE_PARSED, __ATOMIC_RELEASE);
+    }, CATCH_ALL(exception, {
+        BFE_EXCEPTION_HANDLER(exception);
+        pthread_mutex_lock(&self->lock);
+        __atomic_store_n(&self->parseState, BINARY_FILE_FAILED, __ATOMIC_RELEASE);
+    }))
+    pthread_cond_broadcast(&self->parsed);
 }
 
 bool binaryFile_maybeParse(struct binaryFile* self) {
-    if (!self->parsed) {
-        TRY({
-            LCS_FILE(self, parse);
-            self->parsed = true;
-        }, CATCH_ALL(exception, {
-            BFE_EXCEPTION_HANDLER(exception);
-            self->parsed = false;
-        }))
+    enum binaryFile_parseState state = __atomic_load_n(&self->parseState, __ATOMIC_ACQUIRE);
+    if (state == BINARY_FILE_PARSED || state == BINARY_FILE_FAILED) {
+        return state == BINARY_FILE_PARSED;
+    }
+
+    pthread_mutex_lock(&self->lock);
+    while (self->parseState == BINARY_FILE_PARSING) {
+        if (pthread_equal(self->parser, pthread_self())) {
+            // Waiting for ourselves would never return.
+            pthread_mutex_unlock(&self->lock);
+            return false;
+        }
+        pthread_cond_wait(&self->parsed, &self->lock);
+    }
+    if (self->parseState == BINARY_FILE_UNPARSED) {
+        // Read without the lock by the fast path above.
+        __atomic_store_n(&self->parseState, BINARY_FILE_PARSING, __ATOMIC_RELAXED);
+        self->parser = pthread_self();
+        binaryFile_parse(self);
     }
-    return self->parsed;
+    state = self->parseState;
+    pthread_mutex_unlock(&self->lock);
+    return state == BINARY_FILE_PARSED;
 }
 
 void binaryFile_clearCaches(void) {
+    debugInfoCache_invalidate();
 #ifdef LCS_MACHO
     machoFile_clearCaches();
 #endif
@@ -174,6 +269,8 @@ void binaryFile_destroy(struct binaryFile* self) {
     free(self->fileName.absolute);
     free(self->fileName.relative);
     vector_destroy(&self->regions);
+    pthread_mutex_destroy(&self->lock);
+    pthread_cond_destroy(&self->parsed);
 }
 
 void binaryFile_delete(struct binaryFile* self) {
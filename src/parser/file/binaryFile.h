@@ -23,20 +23,51 @@
 #define binaryFile_h
 
 #include <callstack_frame.h>
+#include <pthread.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <functionInfo/functionInfo.h>
 
 #include "vector_pair_ptr.h"
 #include "dwarf/lineInfo/lineInfo.h"
 
+/**
+ * The states of the parsing of a binary file.
+ */
+enum binaryFile_parseState {
+    /** The binary file has not been parsed yet.            */
+    BINARY_FILE_UNPARSED,
+    /** The binary file is being parsed by a thread.        */
+    BINARY_FILE_PARSING,
+    /** The binary file has been parsed successfully.       */
+    BINARY_FILE_PARSED,
+    /** The parsing of the binary file failed.              */
+    BINARY_FILE_FAILED
+};
+
+/**
+ * @brief The thread-local storage of a runtime image, as reported by the
+ * system when the runtime image was loaded.
+ *
+ * The block belongs to the thread the runtime image was reported to.
+ */
+struct binaryFile_tls {
+    /** The module id of the thread-local storage or @c 0 if none.          */
+    size_t module;
+    /** The block of the reporting thread or @c NULL if not allocated.       */
+    const void* block;
+    /** The thread the runtime image was reported to.                        */
+    pthread_t thread;
+};
+
 /**
  * This structure represents a generic binary executable file.
  */
 struct binaryFile {
-    /** Indicates whether this file has already been parsed.             */
-    bool parsed,
+    /** The state of the parsing of this file.                            */
+    enum binaryFile_parseState parseState;
     /** Indicates whether the represented image is loaded by the system. */
-         inMemory,
+    bool inMemory,
     /**
      * Indicates whether the represented image is the located within the image
      * of the CallstackLibrary.
@@ -60,8 +91,18 @@ struct binaryFile {
               * end;
     /** The relocation offset of the binary file.                        */
     uintptr_t relocationOffset;
+    /** The thread-local storage of the represented runtime image.       */
+    struct binaryFile_tls tls;
     /** The regions for global storage in this binary file.              */
     vector_pair_ptr_t regions;
+    /** The lock guarding the parsing and the lazily loaded information.  */
+    pthread_mutex_t lock;
+    /** The condition signalled once the parsing has finished.            */
+    pthread_cond_t parsed;
+    /** The thread parsing this file, if it is being parsed.              */
+    pthread_t parser;
+    /** The count of references to this file.                             */
+    _Atomic size_t references;
 };
 
 /**
@@ -79,8 +120,11 @@ typedef const void* (*binaryFile_searchFunction)(const void*, const void*, size_
 struct binaryFile* binaryFile_new(const char* fileName, const void* startAddress);
 
 /**
- * Deducts the debug information available for the given address and stores it
- * in the given callstack frame.
+ * @brief Deducts the debug information available for the given address and
+ * stores it in the given callstack frame.
+ *
+ * If this binary file cannot be parsed, only the exported symbol of the given
+ * address is deducted, as found by the dynamic linker.
  *
  * @param self the binary file abstraction structure
  * @param address the address to translate
@@ -89,6 +133,21 @@ struct binaryFile* binaryFile_new(const char* fileName, const void* startAddress
  */
 bool binaryFile_addr2String(struct binaryFile* self, const void* address, struct callstack_frame* frame);
 
+/**
+ * @brief Deducts the debug information available for the given addresses and
+ * stores it in the given callstack frames.
+ *
+ * The frames of addresses that could not be translated are left untouched,
+ * their function name remains @c NULL .
+ *
+ * @param self the binary file abstraction structure
+ * @param addresses the addresses to translate, sorted ascendingly
+ * @param frames the callstack frame structures to store the information in
+ * @param count the count of addresses
+ */
+void binaryFile_addr2StringSorted(struct binaryFile* self, void* const addresses[], struct callstack_frame frames[],
+                                  size_t count);
+
 /**
  * Retrieves the function information available in the given binary file object.
  *
@@ -127,17 +186,21 @@ bool binaryFile_getSymbolInfo(struct binaryFile* self, const void* symbolAddress
 void binaryFile_sortRegions(struct binaryFile* self);
 
 /**
- * Returns the thread-local storage regions of the given binary file.
+ * Returns the thread-local storage regions of the given binary file for the
+ * given thread.
  *
  * @param self the binary file abstraction object
+ * @param thread the thread whose thread-local storage regions to return
  * @return the thread-local storage regions in the given binary file
  */
-vector_pair_ptr_t binaryFile_getTLSRegions(struct binaryFile* self);
+vector_pair_ptr_t binaryFile_getTLSRegions(struct binaryFile* self, pthread_t thread);
 
 /**
- * @brief Parses this binary file if it has not been (successfully) parsed.
+ * @brief Parses this binary file if it has not been parsed yet.
  *
- * Stores whether the parsing succeeded.
+ * The file is parsed only once: The first caller parses it, concurrent callers
+ * wait for it to finish and share its result. If called recursively by the
+ * parsing thread, @c false is returned.
  *
  * @param self the binary file to be parsed
  * @return whether the parsing was successful
@@ -172,6 +235,31 @@ void binaryFile_destroy(struct binaryFile* self);
  */
 void binaryFile_delete(struct binaryFile* self);
 
+/**
+ * @brief Adds a reference to the given binary file.
+ *
+ * A newly allocated binary file holds one reference.
+ *
+ * @param self the binary file
+ * @return the given binary file
+ */
+static inline struct binaryFile* binaryFile_retain(struct binaryFile* self) {
+    atomic_fetch_add_explicit(&self->references, 1, memory_order_relaxed);
+    return self;
+}
+
+/**
+ * Removes a reference from the given binary file, deleting it once no
+ * reference is left.
+ *
+ * @param self the binary file
+ */
+static inline void binaryFile_release(struct binaryFile* self) {
+    if (atomic_fetch_sub_explicit(&self->references, 1, memory_order_acq_rel) == 1) {
+        binaryFile_delete(self);
+    }
+}
+
 /**
  * Executes the named function of the binary file class.
  *
@@ -0,0 +1,93 @@
+/*
+ * CallstackLibrary - Library creating human-readable call stacks.
+ *
+ * Copyright (C) 2026  mhahnFr
+ *
+ * This file is part of the CallstackLibrary.
+ *
+ * The CallstackLibrary is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The CallstackLibrary is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with the
+ * CallstackLibrary, see the file LICENSE.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "debugInfoCache.h"
+
+#include <stdatomic.h>
+
+/** The count of cache entries; has to be a power of two. */
+#define DEBUG_INFO_CACHE_SIZE 2048
+
+/**
+ * An entry in the debug information cache, protected by a sequence lock.
+ */
+struct debugInfoCache_entry {
+    /** The sequence number; odd while the entry is written.  */
+    _Atomic uint32_t sequence;
+    /** The generation of the cache the entry was stored in.  */
+    uint32_t generation;
+    /** The absolute address the debug information belongs to. */
+    const void* address;
+    /** The cached debug information.                          */
+    optional_debugInfo_t info;
+};
+
+/** The entries of the cache, keyed by the absolute address.              */
+static struct debugInfoCache_entry debugInfoCache_entries[DEBUG_INFO_CACHE_SIZE];
+/** The current generation; entries of earlier generations are invalid.  */
+static _Atomic uint32_t debugInfoCache_generation = 1;
+
+/**
+ * Returns the cache entry responsible for the given address.
+ *
+ * @param address the absolute address
+ * @return the responsible cache entry
+ */
+static inline struct debugInfoCache_entry* debugInfoCache_entry(const void* address) {
+    return &debugInfoCache_entries[((uintptr_t) address * UINT64_C(0x9e3779b97f4a7c15)) >> 53
+                                   & (DEBUG_INFO_CACHE_SIZE - 1)];
+}
+
+bool debugInfoCache_load(const void* address, optional_debugInfo_t* info) {
+    const struct debugInfoCache_entry* entry = debugInfoCache_entry(address);
+
+    const uint32_t before = atomic_load_explicit(&entry->sequence, memory_order_acquire);
+    if ((before & 1) != 0 || before == 0) return false;
+
+    const uint32_t generation = entry->generation;
+    const void* cachedAddress = entry->address;
+    *info = entry->info;
+    atomic_thread_fence(memory_order_acquire);
+    return cachedAddress == address
+        && generation == atomic_load_explicit(&debugInfoCache_generation, memory_order_relaxed)
+        && atomic_load_explicit(&entry->sequence, memory_order_relaxed) == before;
+}
+
+void debugInfoCache_store(const void* address, const optional_debugInfo_t* info) {
+    struct debugInfoCache_entry* entry = debugInfoCache_entry(address);
+
+    uint32_t sequence = atomic_load_explicit(&entry->sequence, memory_order_relaxed);
+    if ((sequence & 1) != 0
+        || !atomic_compare_exchange_strong_explicit(&entry->sequence, &sequence, sequence + 1,
+                                                    memory_order_acquire, memory_order_relaxed)) {
+        return;
+    }
+    atomic_thread_fence(memory_order_release);
+    entry->generation = atomic_load_explicit(&debugInfoCache_generation, memory_order_relaxed);
+    entry->address    = address;
+    entry->info       = *info;
+    atomic_store_explicit(&entry->sequence, sequence + 2, memory_order_release);
+}
+
+void debugInfoCache_invalidate(void) {
+    atomic_fetch_add_explicit(&debugInfoCache_generation, 1, memory_order_acq_rel);
+}
@@ -0,0 +1,61 @@
+/*
+ * CallstackLibrary - Library creating human-readable call stacks.
+ *
+ * Copyright (C) 2026  mhahnFr
+ *
+ * This file is part of the CallstackLibrary.
+ *
+ * The CallstackLibrary is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The CallstackLibrary is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with the
+ * CallstackLibrary, see the file LICENSE.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef debugInfoCache_h
+#define debugInfoCache_h
+
+#include <stdbool.h>
+
+#include "debugInfo.h"
+
+/**
+ * @brief Loads the cached debug information of the given absolute address.
+ *
+ * Negative results are cached as well; the loaded debug information has no
+ * value in that case. The strings of the debug information are owned by the
+ * binary file the address belongs to. Never takes a lock.
+ *
+ * @param address the absolute address
+ * @param info the debug information to be filled
+ * @return whether the debug information of the address was cached
+ */
+bool debugInfoCache_load(const void* address, optional_debugInfo_t* info);
+
+/**
+ * @brief Caches the given debug information of the given absolute address.
+ *
+ * Replaces the entry of another address if necessary. If the entry is written
+ * by another thread at the same time, nothing is cached.
+ *
+ * @param address the absolute address
+ * @param info the debug information to be cached
+ */
+void debugInfoCache_store(const void* address, const optional_debugInfo_t* info);
+
+/**
+ * @brief Invalidates all cached debug information.
+ *
+ * Must only be called when no thread uses the loaded binary files anymore.
+ */
+void debugInfoCache_invalidate(void);
+
+#endif /* debugInfoCache_h */
@@ -0,0 +1,712 @@
+/*
+ * CallstackLibrary - Library creating human-readable call stacks.
+ *
+ * Copyright (C) 2026  mhahnFr
+ *
+ * This file is part of the CallstackLibrary.
+ *
+ * The CallstackLibrary is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The CallstackLibrary is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with the
+ * CallstackLibrary, see the file LICENSE.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "cfi.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#include "definitions.h"
+#include "../leb128.h"
+
+/** The maximum depth of remembered states supported by the interpreter. */
+#define DWARF_CFI_STATE_DEPTH 4
+
+/** The maximum depth of the DWARF expression stack.                      */
+#define DWARF_CFI_STACK_DEPTH 8
+
+/**
+ * Represents a parsed common information entry.
+ */
+struct dwarf_cfi_cie {
+    /** The code alignment factor.                             */
+    uint64_t codeAlignment;
+    /** The data alignment factor.                             */
+    int64_t dataAlignment;
+    /** The column representing the return address.           */
+    uint16_t returnRegister;
+    /** The pointer encoding used by the FDEs.                 */
+    uint8_t fdeEncoding;
+    /** Whether the augmentation data is present.              */
+    bool hasAugmentation;
+    /** Whether the described frames are signal handler frames. */
+    bool signalFrame;
+    /** The initial instructions.                              */
+    const uint8_t* instructions;
+    /** The end of the initial instructions.                   */
+    const uint8_t* instructionsEnd;
+};
+
+/**
+ * Reads an unsigned LEB128 number from the given position and advances it.
+ *
+ * @param pointer the position to read from
+ * @return the read number
+ */
+static inline uint64_t dwarf_cfi_readULEB(const uint8_t** pointer) {
+    size_t counter = 0;
+    const uint64_t result = getULEB128(*pointer, &counter);
+    *pointer += counter;
+    return result;
+}
+
+/**
+ * Reads a signed LEB128 number from the given position and advances it.
+ *
+ * @param pointer the position to read from
+ * @return the read number
+ */
+static inline int64_t dwarf_cfi_readLEB(const uint8_t** pointer) {
+    size_t counter = 0;
+    const int64_t result = getLEB128(*pointer, &counter);
+    *pointer += counter;
+    return result;
+}
+
+/**
+ * Generates a function reading a possibly unaligned value of the given type
+ * and advancing the given position.
+ *
+ * @param name the name suffix of the generated function
+ * @param type the type to read
+ */
+#define dwarf_cfi_readFixed(name, type)                                 \
+static inline type dwarf_cfi_read##name(const uint8_t** pointer) {     \
+    type result;                                                        \
+    memcpy(&result, *pointer, sizeof(type));                            \
+    *pointer += sizeof(type);                                           \
+    return result;                                                      \
+}
+
+dwarf_cfi_readFixed(U16, uint16_t)
+dwarf_cfi_readFixed(U32, uint32_t)
+dwarf_cfi_readFixed(U64, uint64_t)
+dwarf_cfi_readFixed(Pointer, uintptr_t)
+
+/**
+ * Reads a pointer in the given encoding from the given position and advances
+ * the position.
+ *
+ * @param pointer the position to read from
+ * @param encoding the @c DW_EH_PE encoding of the pointer
+ * @param dataBase the base address used for data relative pointers
+ * @param result the read pointer
+ * @return whether the pointer could be read
+ */
+static inline bool dwarf_cfi_readEncoded(const uint8_t** pointer, const uint8_t encoding,
+                                         const uintptr_t dataBase, uintptr_t* result) {
+    if (encoding == DW_EH_PE_omit) return false;
+
+    const uintptr_t fieldAddress = (uintptr_t) *pointer;
+    uintptr_t value;
+    switch (encoding & 0x0f) {
+        case DW_EH_PE_absptr:  value = dwarf_cfi_readPointer(pointer);                   break;
+        case DW_EH_PE_uleb128: value = dwarf_cfi_readULEB(pointer);                      break;
+        case DW_EH_PE_udata2:  value = dwarf_cfi_readU16(pointer);                       break;
+        case DW_EH_PE_udata4:  value = dwarf_cfi_readU32(pointer);                       break;
+        case DW_EH_PE_udata8:  value = dwarf_cfi_readU64(pointer);                       break;
+        case DW_EH_PE_sleb128: value = dwarf_cfi_readLEB(pointer);                       break;
+        case DW_EH_PE_sdata2:  value = (intptr_t) (int16_t) dwarf_cfi_readU16(pointer);  break;
+        case DW_EH_PE_sdata4:  value = (intptr_t) (int32_t) dwarf_cfi_readU32(pointer);  break;
+        case DW_EH_PE_sdata8:  value = (intptr_t) (int64_t) dwarf_cfi_readU64(pointer);  break;
+
+        default: return false;
+    }
+    switch (encoding & 0x70) {
+        case DW_EH_PE_absptr:                         break;
+        case DW_EH_PE_pcrel:   value += fieldAddress; break;
+        case DW_EH_PE_datarel: value += dataBase;     break;
+
+        default: return false;
+    }
+    if ((encoding & DW_EH_PE_indirect) != 0) {
+        value = *(const uintptr_t*) value;
+    }
+    *result = value;
+    return true;
+}
+
+/**
+ * Returns the size of a table entry value of the given encoding.
+ *
+ * @param encoding the @c DW_EH_PE encoding
+ * @return the size in bytes or @c 0 if the encoding has no fixed size
+ */
+static inline size_t dwarf_cfi_encodingSize(const uint8_t encoding) {
+    switch (encoding & 0x0f) {
+        case DW_EH_PE_udata2:
+        case DW_EH_PE_sdata2: return 2;
+
+        case DW_EH_PE_udata4:
+        case DW_EH_PE_sdata4: return 4;
+
+        case DW_EH_PE_udata8:
+        case DW_EH_PE_sdata8: return 8;
+
+        case DW_EH_PE_absptr: return sizeof(uintptr_t);
+
+        default: return 0;
+    }
+}
+
+/**
+ * Reads the length of a CIE or FDE and advances the given position.
+ *
+ * @param pointer the position of the entry
+ * @param end the end of the entry to be filled
+ * @return whether the entry is valid and not the terminator
+ */
+static inline bool dwarf_cfi_readLength(const uint8_t** pointer, const uint8_t** end) {
+    uint64_t length = dwarf_cfi_readU32(pointer);
+    if (length == 0) return false;
+    if (length == UINT32_MAX) {
+        length = dwarf_cfi_readU64(pointer);
+    }
+    *end = *pointer + length;
+    return true;
+}
+
+/**
+ * Parses the common information entry at the given position.
+ *
+ * @param entry the start of the CIE
+ * @param cie the CIE structure to be filled
+ * @return whether the CIE could be parsed
+ */
+static inline bool dwarf_cfi_parseCIE(const uint8_t* entry, struct dwarf_cfi_cie* cie) {
+    const uint8_t* end;
+    if (!dwarf_cfi_readLength(&entry, &end)) return false;
+
+    // The CIE id is zero in .eh_frame sections.
+    if (dwarf_cfi_readU32(&entry) != 0) return false;
+
+    const uint8_t version = *entry++;
+    const char* augmentation = (const char*) entry;
+    entry += strlen(augmentation) + 1;
+    if (augmentation[0] == 'e' && augmentation[1] == 'h') {
+        entry += sizeof(void*);
+        augmentation += 2;
+    }
+    cie->codeAlignment   = dwarf_cfi_readULEB(&entry);
+    cie->dataAlignment   = dwarf_cfi_readLEB(&entry);
+    cie->returnRegister  = version == 1 ? *entry++ : (uint16_t) dwarf_cfi_readULEB(&entry);
+    cie->fdeEncoding     = DW_EH_PE_absptr;
+    cie->hasAugmentation = false;
+    cie->signalFrame     = false;
+
+    const uint8_t* augmentationEnd = NULL;
+    for (bool known = true; known && *augmentation != '\0'; ++augmentation) {
+        switch (*augmentation) {
+            case 'z': {
+                cie->hasAugmentation = true;
+                const uint64_t length = dwarf_cfi_readULEB(&entry);
+                augmentationEnd = entry + length;
+                break;
+            }
+
+            case 'L':
+                ++entry;
+                break;
+
+            case 'R':
+                cie->fdeEncoding = *entry++;
+                break;
+
+            case 'P': {
+                const uint8_t encoding = *entry++;
+                uintptr_t personality;
+                if (!dwarf_cfi_readEncoded(&entry, encoding & ~DW_EH_PE_indirect, 0, &personality)) return false;
+                break;
+            }
+
+            case 'S':
+                cie->signalFrame = true;
+                break;
+
+            case 'B':
+            case 'G':
+                break;
+
+            default:
+                // Unknown augmentations can only be skipped using the augmentation length.
+                if (augmentationEnd == NULL) return false;
+                known = false;
+                break;
+        }
+    }
+    if (augmentationEnd != NULL) {
+        entry = augmentationEnd;
+    }
+    cie->instructions    = entry;
+    cie->instructionsEnd = end;
+    return entry <= end;
+}
+
+/**
+ * Returns the rule slot of the given register.
+ *
+ * @param row the row
+ * @param reg the DWARF register number
+ * @return the rule slot or @c NULL if the register is not tracked
+ */
+static inline struct dwarf_cfi_rule* dwarf_cfi_ruleFor(struct dwarf_cfi_row* row, const uint64_t reg) {
+    return reg < DWARF_CFI_REGISTERS ? &row->rules[reg] : NULL;
+}
+
+/**
+ * Sets the rule of the given register, if it is tracked.
+ *
+ * @param row the row
+ * @param reg the DWARF register number
+ * @param type the kind of rule
+ * @param value the value of the rule
+ */
+static inline void dwarf_cfi_setRule(struct dwarf_cfi_row* row, const uint64_t reg,
+                                     const enum dwarf_cfi_ruleType type, const int64_t value) {
+    struct dwarf_cfi_rule* rule = dwarf_cfi_ruleFor(row, reg);
+    if (rule != NULL) {
+        *rule = (struct dwarf_cfi_rule) { .type = type, .value = value };
+    }
+}
+
+/**
+ * Advances the given location by the given delta.
+ *
+ * @param cie the CIE the advancing instruction belongs to
+ * @param location the location to be advanced
+ * @param delta the delta in code alignment units
+ * @param pc the program counter whose row is computed
+ * @return whether the new location still belongs to the row of the program counter
+ */
+static inline bool dwarf_cfi_advance(const struct dwarf_cfi_cie* cie, uintptr_t* location,
+                                     const uint64_t delta, const uintptr_t pc) {
+    *location += delta * cie->codeAlignment;
+    return *location <= pc;
+}
+
+/**
+ * Restores the rule of the given register to the one of the given initial row.
+ *
+ * @param row the row
+ * @param initial the row after the initial instructions of the CIE or @c NULL
+ * @param reg the DWARF register number
+ * @return whether the rule could be restored
+ */
+static inline bool dwarf_cfi_restore(struct dwarf_cfi_row* row, const struct dwarf_cfi_row* initial,
+                                     const uint64_t reg) {
+    if (initial == NULL) return false;
+
+    if (reg < DWARF_CFI_REGISTERS) {
+        row->rules[reg] = initial->rules[reg];
+    }
+    return true;
+}
+
+/**
+ * Skips the length prefixed expression block at the given position.
+ *
+ * @param instructions the position of the expression block
+ * @return the start of the expression block
+ */
+static inline const uint8_t* dwarf_cfi_skipBlock(const uint8_t** instructions) {
+    const uint8_t* block = *instructions;
+    const uint64_t length = dwarf_cfi_readULEB(instructions);
+    *instructions += length;
+    return block;
+}
+
+/**
+ * @brief Executes the given call frame instructions.
+ *
+ * The execution stops once the location exceeds the given program counter.
+ *
+ * @param cie the CIE the instructions belong to
+ * @param instructions the instructions
+ * @param end the end of the instructions
+ * @param location the initial location
+ * @param pc the program counter whose row to compute
+ * @param initial the row after the initial instructions of the CIE or @c NULL
+ * while executing them
+ * @param row the row to be updated
+ * @return whether the instructions could be executed
+ */
+static inline bool dwarf_cfi_execute(const struct dwarf_cfi_cie* cie,
+                                     const uint8_t* instructions, const uint8_t* end,
+                                     uintptr_t location, const uintptr_t pc,
+                                     const struct dwarf_cfi_row* initial, struct dwarf_cfi_row* row) {
+    struct dwarf_cfi_row states[DWARF_CFI_STATE_DEPTH];
+    size_t stateCount = 0;
+
+    while (instructions < end) {
+        const uint8_t instruction = *instructions++;
+        uint64_t reg;
+        int64_t offset;
+
+        switch (instruction & 0xc0) {
+            case DW_CFA_advance_loc:
+                if (!dwarf_cfi_advance(cie, &location, instruction & 0x3f, pc)) return true;
+                continue;
+
+            case DW_CFA_offset:
+                offset = (int64_t) dwarf_cfi_readULEB(&instructions) * cie->dataAlignment;
+                dwarf_cfi_setRule(row, instruction & 0x3f, DWARF_CFI_RULE_OFFSET, offset);
+                continue;
+
+            case DW_CFA_restore:
+                if (!dwarf_cfi_restore(row, initial, instruction & 0x3f)) return false;
+                continue;
+
+            default: break;
+        }
+
+        switch (instruction) {
+            case DW_CFA_nop:
+                break;
+
+            case DW_CFA_AARCH64_negate_ra_state:
+                row->returnAddressSigned = !row->returnAddressSigned;
+                break;
+
+            case DW_CFA_set_loc:
+                if (!dwarf_cfi_readEncoded(&instructions, cie->fdeEncoding, 0, &location)) return false;
+                if (location > pc) return true;
+                break;
+
+            case DW_CFA_advance_loc1:
+                if (!dwarf_cfi_advance(cie, &location, *instructions++, pc)) return true;
+                break;
+
+            case DW_CFA_advance_loc2:
+                if (!dwarf_cfi_advance(cie, &location, dwarf_cfi_readU16(&instructions), pc)) return true;
+                break;
+
+            case DW_CFA_advance_loc4:
+                if (!dwarf_cfi_advance(cie, &location, dwarf_cfi_readU32(&instructions), pc)) return true;
+                break;
+
+            case DW_CFA_offset_extended:
+                reg    = dwarf_cfi_readULEB(&instructions);
+                offset = (int64_t) dwarf_cfi_readULEB(&instructions) * cie->dataAlignment;
+                dwarf_cfi_setRule(row, reg, DWARF_CFI_RULE_OFFSET, offset);
+                break;
+
+            case DW_CFA_offset_extended_sf:
+                reg    = dwarf_cfi_readULEB(&instructions);
+                offset = dwarf_cfi_readLEB(&instructions) * cie->dataAlignment;
+                dwarf_cfi_setRule(row, reg, DWARF_CFI_RULE_OFFSET, offset);
+                break;
+
+            case DW_CFA_GNU_negative_offset_extended:
+                reg    = dwarf_cfi_readULEB(&instructions);
+                offset = -(int64_t) dwarf_cfi_readULEB(&instructions) * cie->dataAlignment;
+                dwarf_cfi_setRule(row, reg, DWARF_CFI_RULE_OFFSET, offset);
+                break;
+
+            case DW_CFA_val_offset:
+                reg    = dwarf_cfi_readULEB(&instructions);
+                offset = (int64_t) dwarf_cfi_readULEB(&instructions) * cie->dataAlignment;
+                dwarf_cfi_setRule(row, reg, DWARF_CFI_RULE_VAL_OFFSET, offset);
+                break;
+
+            case DW_CFA_val_offset_sf:
+                reg    = dwarf_cfi_readULEB(&instructions);
+                offset = dwarf_cfi_readLEB(&instructions) * cie->dataAlignment;
+                dwarf_cfi_setRule(row, reg, DWARF_CFI_RULE_VAL_OFFSET, offset);
+                break;
+
+            case DW_CFA_restore_extended:
+                if (!dwarf_cfi_restore(row, initial, dwarf_cfi_readULEB(&instructions))) return false;
+                break;
+
+            case DW_CFA_undefined:
+                dwarf_cfi_setRule(row, dwarf_cfi_readULEB(&instructions), DWARF_CFI_RULE_UNDEFINED, 0);
+                break;
+
+            case DW_CFA_same_value:
+                dwarf_cfi_setRule(row, dwarf_cfi_readULEB(&instructions), DWARF_CFI_RULE_SAME_VALUE, 0);
+                break;
+
+            case DW_CFA_register:
+                reg = dwarf_cfi_readULEB(&instructions);
+                dwarf_cfi_setRule(row, reg, DWARF_CFI_RULE_REGISTER, (int64_t) dwarf_cfi_readULEB(&instructions));
+                break;
+
+            case DW_CFA_remember_state:
+                if (stateCount == DWARF_CFI_STATE_DEPTH) return false;
+                states[stateCount++] = *row;
+                break;
+
+            case DW_CFA_restore_state:
+                if (stateCount == 0) return false;
+                // Like libgcc, the CFA is treated as part of the remembered state.
+                *row = states[--stateCount];
+                break;
+
+            case DW_CFA_def_cfa:
+                row->cfaRegister   = (uint16_t) dwarf_cfi_readULEB(&instructions);
+                row->cfaOffset     = (int64_t) dwarf_cfi_readULEB(&instructions);
+                row->cfaExpression = NULL;
+                break;
+
+            case DW_CFA_def_cfa_sf:
+                row->cfaRegister   = (uint16_t) dwarf_cfi_readULEB(&instructions);
+                row->cfaOffset     = dwarf_cfi_readLEB(&instructions) * cie->dataAlignment;
+                row->cfaExpression = NULL;
+                break;
+
+            case DW_CFA_def_cfa_register:
+                row->cfaRegister   = (uint16_t) dwarf_cfi_readULEB(&instructions);
+                row->cfaExpression = NULL;
+                break;
+
+            case DW_CFA_def_cfa_offset:
+                row->cfaOffset = (int64_t) dwarf_cfi_readULEB(&instructions);
+                break;
+
+            case DW_CFA_def_cfa_offset_sf:
+                row->cfaOffset = dwarf_cfi_readLEB(&instructions) * cie->dataAlignment;
+                break;
+
+            case DW_CFA_def_cfa_expression:
+                row->cfaExpression = dwarf_cfi_skipBlock(&instructions);
+                break;
+
+            case DW_CFA_expression:
+            case DW_CFA_val_expression:
+                reg = dwarf_cfi_readULEB(&instructions);
+                dwarf_cfi_setRule(row, reg, instruction == DW_CFA_expression ? DWARF_CFI_RULE_EXPRESSION
+                                                                             : DWARF_CFI_RULE_VAL_EXPRESSION,
+                                  (int64_t) (uintptr_t) dwarf_cfi_skipBlock(&instructions));
+                break;
+
+            case DW_CFA_GNU_args_size:
+                (void) dwarf_cfi_readULEB(&instructions);
+                break;
+
+            default: return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Searches the binary search table of the given @c .eh_frame_hdr section for
+ * the frame description entry possibly covering the given program counter.
+ *
+ * @param header the in-memory @c .eh_frame_hdr section
+ * @param pc the program counter
+ * @return the frame description entry or @c NULL if not found
+ */
+static inline const uint8_t* dwarf_cfi_searchTable(const uint8_t* header, const uintptr_t pc) {
+    // Version, eh_frame_ptr encoding, fde_count encoding, table encoding
+    if (header[0] != 1) return NULL;
+
+    const uint8_t tableEncoding = header[3];
+    const uint8_t* pointer = header + 4;
+    uintptr_t ehFrame, count;
+    if (!dwarf_cfi_readEncoded(&pointer, header[1], (uintptr_t) header, &ehFrame)
+        || !dwarf_cfi_readEncoded(&pointer, header[2], (uintptr_t) header, &count)
+        || (tableEncoding & 0x70) != DW_EH_PE_datarel) {
+        return NULL;
+    }
+    const size_t valueSize = dwarf_cfi_encodingSize(tableEncoding);
+    if (valueSize == 0 || count == 0) return NULL;
+
+    const uint8_t* table = pointer;
+    size_t low = 0, high = count;
+    while (high - low > 1) {
+        const size_t middle = low + (high - low) / 2;
+        const uint8_t* entry = table + middle * 2 * valueSize;
+        uintptr_t start;
+        if (!dwarf_cfi_readEncoded(&entry, tableEncoding, (uintptr_t) header, &start)) return NULL;
+        if (start <= pc) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+    const uint8_t* entry = table + low * 2 * valueSize;
+    uintptr_t start, fde;
+    if (!dwarf_cfi_readEncoded(&entry, tableEncoding, (uintptr_t) header, &start)
+        || !dwarf_cfi_readEncoded(&entry, tableEncoding, (uintptr_t) header, &fde)) {
+        return NULL;
+    }
+    return start <= pc ? (const uint8_t*) fde : NULL;
+}
+
+bool dwarf_cfi_findRow(const void* ehFrameHeader, const uintptr_t pc, struct dwarf_cfi_row* row) {
+    const uint8_t* entry = dwarf_cfi_searchTable(ehFrameHeader, pc);
+    if (entry == NULL) return false;
+
+    const uint8_t* end;
+    if (!dwarf_cfi_readLength(&entry, &end)) return false;
+
+    const uint8_t* ciePointerField = entry;
+    const uint32_t ciePointer = dwarf_cfi_readU32(&entry);
+    if (ciePointer == 0) return false;
+
+    struct dwarf_cfi_cie cie;
+    if (!dwarf_cfi_parseCIE(ciePointerField - ciePointer, &cie)) return false;
+
+    uintptr_t begin, range;
+    if (!dwarf_cfi_readEncoded(&entry, cie.fdeEncoding, 0, &begin)
+        || !dwarf_cfi_readEncoded(&entry, cie.fdeEncoding & 0x0f, 0, &range)
+        || pc < begin || pc >= begin + range) {
+        return false;
+    }
+    if (cie.hasAugmentation) {
+        entry += dwarf_cfi_readULEB(&entry);
+    }
+
+    *row = (struct dwarf_cfi_row) {
+        .cfaRegister         = 0,
+        .cfaOffset           = 0,
+        .cfaExpression       = NULL,
+        .returnRegister      = cie.returnRegister,
+        .signalFrame         = cie.signalFrame,
+        .returnAddressSigned = false,
+    };
+    if (!dwarf_cfi_execute(&cie, cie.instructions, cie.instructionsEnd, begin, UINTPTR_MAX, NULL, row)) {
+        return false;
+    }
+    const struct dwarf_cfi_row initial = *row;
+    return dwarf_cfi_execute(&cie, entry, end, begin, pc, &initial, row);
+}
+
+/**
+ * @brief Applies the given binary DWARF operation.
+ *
+ * The comparisons are signed, as are the arithmetic shifts.
+ *
+ * @param operation the operation
+ * @param lhs the second entry of the stack
+ * @param rhs the top entry of the stack
+ * @param result the result to be filled
+ * @return whether the operation is a supported binary operation
+ */
+static inline bool dwarf_cfi_applyBinary(const uint8_t operation, const uintptr_t lhs, const uintptr_t rhs,
+                                         uintptr_t* result) {
+    const uintptr_t bits = 8 * sizeof(uintptr_t);
+    switch (operation) {
+        case DW_OP_and:   *result = lhs & rhs;                                                     break;
+        case DW_OP_or:    *result = lhs | rhs;                                                     break;
+        case DW_OP_xor:   *result = lhs ^ rhs;                                                     break;
+        case DW_OP_plus:  *result = lhs + rhs;                                                     break;
+        case DW_OP_minus: *result = lhs - rhs;                                                     break;
+        case DW_OP_shl:   *result = rhs < bits ? lhs << rhs : 0;                                   break;
+        case DW_OP_shr:   *result = rhs < bits ? lhs >> rhs : 0;                                   break;
+        case DW_OP_shra:  *result = (uintptr_t) ((intptr_t) lhs >> (rhs < bits ? rhs : bits - 1)); break;
+        case DW_OP_eq:    *result = lhs == rhs;                                                    break;
+        case DW_OP_ne:    *result = lhs != rhs;                                                    break;
+        case DW_OP_ge:    *result = (intptr_t) lhs >= (intptr_t) rhs;                              break;
+        case DW_OP_gt:    *result = (intptr_t) lhs >  (intptr_t) rhs;                              break;
+        case DW_OP_le:    *result = (intptr_t) lhs <= (intptr_t) rhs;                              break;
+        case DW_OP_lt:    *result = (intptr_t) lhs <  (intptr_t) rhs;                              break;
+
+        default: return false;
+    }
+    return true;
+}
+
+bool dwarf_cfi_evaluate(const uint8_t* expression,
+                        const uintptr_t registers[DWARF_CFI_REGISTERS], const uint64_t validRegisters,
+                        const uintptr_t initial, const dwarf_cfi_memoryReader reader, void* args,
+                        uintptr_t* result) {
+    uintptr_t stack[DWARF_CFI_STACK_DEPTH];
+    size_t count = 0;
+    stack[count++] = initial;
+
+    const uint64_t length = dwarf_cfi_readULEB(&expression);
+    const uint8_t* end = expression + length;
+    while (expression < end) {
+        const uint8_t operation = *expression++;
+        if (count == DWARF_CFI_STACK_DEPTH) return false;
+
+        if (operation >= DW_OP_lit0 && operation <= DW_OP_lit31) {
+            stack[count++] = operation - DW_OP_lit0;
+            continue;
+        }
+        if (operation >= DW_OP_breg0 && operation <= DW_OP_breg31) {
+            const unsigned reg = operation - DW_OP_breg0;
+            if ((validRegisters & (UINT64_C(1) << reg)) == 0) return false;
+            stack[count++] = registers[reg] + dwarf_cfi_readLEB(&expression);
+            continue;
+        }
+        switch (operation) {
+            case DW_OP_deref:
+                if (count == 0 || !reader(stack[count - 1], &stack[count - 1], args)) return false;
+                break;
+
+            case DW_OP_const1u: stack[count++] = *expression++;                                 break;
+            case DW_OP_const1s: stack[count++] = (intptr_t) (int8_t) *expression++;             break;
+            case DW_OP_const2u: stack[count++] = dwarf_cfi_readU16(&expression);                break;
+            case DW_OP_const2s: stack[count++] = (intptr_t) (int16_t) dwarf_cfi_readU16(&expression); break;
+            case DW_OP_const4u: stack[count++] = dwarf_cfi_readU32(&expression);                break;
+            case DW_OP_const4s: stack[count++] = (intptr_t) (int32_t) dwarf_cfi_readU32(&expression); break;
+            case DW_OP_const8u:
+            case DW_OP_const8s: stack[count++] = dwarf_cfi_readU64(&expression);                break;
+            case DW_OP_constu:  stack[count++] = dwarf_cfi_readULEB(&expression);               break;
+            case DW_OP_consts:  stack[count++] = dwarf_cfi_readLEB(&expression);                break;
+
+            case DW_OP_plus_uconst:
+                if (count == 0) return false;
+                stack[count - 1] += dwarf_cfi_readULEB(&expression);
+                break;
+
+            case DW_OP_dup:
+                if (count == 0) return false;
+                stack[count] = stack[count - 1];
+                ++count;
+                break;
+
+            case DW_OP_drop:
+                if (count == 0) return false;
+                --count;
+                break;
+
+            case DW_OP_over:
+                if (count < 2) return false;
+                stack[count] = stack[count - 2];
+                ++count;
+                break;
+
+            case DW_OP_swap: {
+                if (count < 2) return false;
+                const uintptr_t top = stack[count - 1];
+                stack[count - 1] = stack[count - 2];
+                stack[count - 2] = top;
+                break;
+            }
+
+            default:
+                if (count < 2 || !dwarf_cfi_applyBinary(operation, stack[count - 2], stack[count - 1],
+                                                        &stack[count - 2])) {
+                    return false;
+                }
+                --count;
+                break;
+        }
+    }
+    if (count == 0) return false;
+
+    *result = stack[count - 1];
+    return true;
+}
@@ -0,0 +1,126 @@
+/*
+ * CallstackLibrary - Library creating human-readable call stacks.
+ *
+ * Copyright (C) 2026  mhahnFr
+ *
+ * This file is part of the CallstackLibrary.
+ *
+ * The CallstackLibrary is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The CallstackLibrary is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with the
+ * CallstackLibrary, see the file LICENSE.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef dwarf_cfi_h
+#define dwarf_cfi_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** The count of registers whose rules are tracked by the CFI interpreter. */
+#define DWARF_CFI_REGISTERS 33
+
+/**
+ * The kinds of rules describing how to restore a register.
+ */
+enum dwarf_cfi_ruleType {
+    /** The register has not been modified.                                      */
+    DWARF_CFI_RULE_SAME_VALUE,
+    /** The register cannot be restored.                                         */
+    DWARF_CFI_RULE_UNDEFINED,
+    /** The register is saved at the CFA plus the offset.                        */
+    DWARF_CFI_RULE_OFFSET,
+    /** The value of the register is the CFA plus the offset.                    */
+    DWARF_CFI_RULE_VAL_OFFSET,
+    /** The register is saved in another register.                              */
+    DWARF_CFI_RULE_REGISTER,
+    /** The register is saved at the address computed by the expression.        */
+    DWARF_CFI_RULE_EXPRESSION,
+    /** The value of the register is computed by the expression.                */
+    DWARF_CFI_RULE_VAL_EXPRESSION
+};
+
+/**
+ * Represents the rule for restoring a single register.
+ */
+struct dwarf_cfi_rule {
+    /** The kind of this rule.                                                   */
+    uint8_t type;
+    /** The offset, the register number or the address of the expression block. */
+    int64_t value;
+};
+
+/**
+ * Represents a row of the call frame information table.
+ */
+struct dwarf_cfi_row {
+    /** The register the CFA is computed from.                           */
+    uint16_t cfaRegister;
+    /** The offset added to the CFA register.                            */
+    int64_t cfaOffset;
+    /** The expression block computing the CFA or @c NULL if not used.   */
+    const uint8_t* cfaExpression;
+    /** The column representing the return address.                     */
+    uint16_t returnRegister;
+    /** Whether this row describes a signal handler frame.               */
+    bool signalFrame;
+    /** Whether the return address is signed by pointer authentication.  */
+    bool returnAddressSigned;
+    /** The rules for restoring the registers.                           */
+    struct dwarf_cfi_rule rules[DWARF_CFI_REGISTERS];
+};
+
+/**
+ * @brief The function prototype for reading a memory word during the
+ * evaluation of DWARF expressions.
+ *
+ * Implementations should verify the given address before reading from it.
+ *
+ * @param address the address to read from
+ * @param value the value to be filled
+ * @param args the payload
+ * @return whether the memory could be read
+ */
+typedef bool (*dwarf_cfi_memoryReader)(uintptr_t address, uintptr_t* value, void* args);
+
+/**
+ * @brief Finds the call frame information row for the given program counter.
+ *
+ * The frame description entry is looked up using the binary search table of
+ * the given @c .eh_frame_hdr section. This function neither allocates nor
+ * locks, it can therefore be used in signal handlers.
+ *
+ * @param ehFrameHeader the in-memory @c .eh_frame_hdr section
+ * @param pc the program counter whose row to find
+ * @param row the row structure to be filled
+ * @return whether a row was found
+ */
+bool dwarf_cfi_findRow(const void* ehFrameHeader, uintptr_t pc, struct dwarf_cfi_row* row);
+
+/**
+ * @brief Evaluates the given DWARF expression block.
+ *
+ * Only the operations commonly used in call frame information are supported.
+ *
+ * @param expression the expression block, starting with its length
+ * @param registers the values of the registers
+ * @param validRegisters the bit mask indicating which register values are valid
+ * @param initial the value initially pushed onto the stack
+ * @param reader the function used to read memory
+ * @param args the payload for the memory reading function
+ * @param result the result of the evaluation
+ * @return whether the expression could be evaluated
+ */
+bool dwarf_cfi_evaluate(const uint8_t* expression,
+                        const uintptr_t registers[DWARF_CFI_REGISTERS], uint64_t validRegisters,
+                        uintptr_t initial, dwarf_cfi_memoryReader reader, void* args, uintptr_t* result);
+
+#endif /* dwarf_cfi_h */
@@ -1,7 +1,7 @@
 /*
  * CallstackLibrary - Library creating human-readable call stacks.
  *
- * Copyright (C) 2024 - 2025  mhahnFr
+ * Copyright (C) 2024 - 2026  mhahnFr
  *
  * This file is part of the CallstackLibrary.
  *
@@ -19,43 +19,115 @@
  * CallstackLibrary, see the file LICENSE.  If not, see <https://www.gnu.org/licenses/>.
  */
 
-#include <stdbool.h>
-
 #include "leb128.h"
 
-uint64_t getULEB128(const void* begin, size_t* counter) {
-    uint64_t result = 0,
-             shift  = 0;
-
-    bool more = true;
+/**
+ * @brief Accumulates the remaining bytes of a LEB128 number.
+ *
+ * Bits beyond the 64th are discarded.
+ *
+ * @param bytes the bytes of the number
+ * @param index the index of the next byte, set behind the number
+ * @param shift the shift of the next byte, set behind the number
+ * @param result the already accumulated bits
+ * @return the accumulated bits of the whole number
+ */
+static inline uint64_t leb128_accumulate(const uint8_t* bytes, size_t* index, unsigned* shift, uint64_t result) {
+    uint8_t byte;
     do {
-        const uint8_t b = *(const uint8_t*) (begin + *counter);
-        *counter += 1;
-        result |= (b & 0x7f) << shift;
-        shift += 7;
-        if (b < 0x80) {
-            more = false;
+        byte = bytes[(*index)++];
+        if (*shift < 64) {
+            result |= (uint64_t) (byte & 0x7f) << *shift;
         }
-    } while (more);
+        *shift += 7;
+    } while (byte >= 0x80);
     return result;
 }
 
-int64_t getLEB128(const void* begin, size_t* counter) {
-    int64_t result = 0,
-            shift  = 0;
+uint64_t getULEB128Long(const void* begin, size_t* counter) {
+    const uint8_t* bytes = (const uint8_t*) begin + *counter;
 
-    bool more = true;
-    do {
-        const uint8_t b = *(const uint8_t*) (begin + *counter);
-        *counter += 1;
-        result |= (b & 0x7f) << shift;
-        shift += 7;
-        if ((0x80 & b) == 0) {
-            if (shift < 32 && (b & 0x40) != 0) {
-                result |= (int64_t) ((uint64_t) ~0 << shift);
-            }
-            more = false;
-        }
-    } while (more);
+    uint64_t result = bytes[0] & 0x7f;
+    if (bytes[1] < 0x80) {
+        *counter += 2;
+        return result | (uint64_t) bytes[1] << 7;
+    }
+    result |= (uint64_t) (bytes[1] & 0x7f) << 7;
+    if (bytes[2] < 0x80) {
+        *counter += 3;
+        return result | (uint64_t) bytes[2] << 14;
+    }
+    result |= (uint64_t) (bytes[2] & 0x7f) << 14;
+
+    size_t index = 3;
+    unsigned shift = 21;
+    result = leb128_accumulate(bytes, &index, &shift, result);
+    *counter += index;
     return result;
 }
+
+/**
+ * Sign-extends the given accumulated bits of a signed LEB128 number.
+ *
+ * @param result the accumulated bits
+ * @param shift the number of the accumulated bits
+ * @param last the last byte of the number
+ * @return the signed number
+ */
+static inline int64_t leb128_signExtend(const uint64_t result, const unsigned shift, const uint8_t last) {
+    if (shift < 64 && (last & 0x40) != 0) {
+        return (int64_t) (result | ~(uint64_t) 0 << shift);
+    }
+    return (int64_t) result;
+}
+
+int64_t getLEB128Long(const void* begin, size_t* counter) {
+    const uint8_t* bytes = (const uint8_t*) begin + *counter;
+
+    uint64_t result = bytes[0] & 0x7f;
+    if (bytes[1] < 0x80) {
+        *counter += 2;
+        return leb128_signExtend(result | (uint64_t) bytes[1] << 7, 14, bytes[1]);
+    }
+    result |= (uint64_t) (bytes[1] & 0x7f) << 7;
+
+    size_t index = 2;
+    unsigned shift = 14;
+    result = leb128_accumulate(bytes, &index, &shift, result);
+    *counter += index;
+    return leb128_signExtend(result, shift, bytes[index - 1]);
+}
+
+/**
+ * Returns the length of the LEB128 number at the given position.
+ *
+ * @param begin the memory pointer
+ * @param size the size of the memory
+ * @param counter the memory position
+ * @return the length in bytes or @c 0 if the number is not terminated within the memory
+ */
+static inline size_t leb128_boundedLength(const void* begin, const size_t size, const size_t counter) {
+    const uint8_t* bytes = begin;
+    for (size_t i = counter; i < size; ++i) {
+        if (bytes[i] < 0x80) {
+            return i - counter + 1;
+        }
+    }
+    return 0;
+}
+
+bool getULEB128Bounded(const void* begin, const size_t size, size_t* counter, uint64_t* result) {
+    if (leb128_boundedLength(begin, size, *counter) == 0) {
+        return false;
+    }
+    *result = getULEB128(begin, counter);
+    return true;
+}
+
+bool getLEB128Bounded(const void* begin, const size_t size, size_t* counter, int64_t* result) {
+    if (leb128_boundedLength(begin, size, *counter) == 0) {
+        return false;
+    }
+    *result = getLEB128(begin, counter);
+    return true;
+}
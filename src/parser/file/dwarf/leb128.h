@@ -1,7 +1,7 @@
 /*
  * CallstackLibrary - Library creating human-readable call stacks.
  *
- * Copyright (C) 2024 - 2025  mhahnFr
+ * Copyright (C) 2024 - 2026  mhahnFr
  *
  * This file is part of the CallstackLibrary.
  *
@@ -22,9 +22,34 @@
 #ifndef leb128_h
 #define leb128_h
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
+/**
+ * @brief Reads an unsigned LEB128 integer of more than one byte from the given
+ * memory at the given position.
+ *
+ * Use @c getULEB128 instead.
+ *
+ * @param begin the memory pointer
+ * @param counter the memory position
+ * @return the deducted number
+ */
+uint64_t getULEB128Long(const void* begin, size_t* counter);
+
+/**
+ * @brief Reads a signed LEB128 integer of more than one byte from the given
+ * memory at the given position.
+ *
+ * Use @c getLEB128 instead.
+ *
+ * @param begin the memory pointer
+ * @param counter the memory position
+ * @return the deducted number
+ */
+int64_t getLEB128Long(const void* begin, size_t* counter);
+
 /**
  * @brief Reads an unsigned LEB128 integer from the given memory at the given
  * position.
@@ -36,7 +61,14 @@
  * @param counter the memory position
  * @return the deducted number
  */
-uint64_t getULEB128(const void* begin, size_t* counter);
+static inline uint64_t getULEB128(const void* begin, size_t* counter) {
+    const uint8_t byte = *((const uint8_t*) begin + *counter);
+    if (byte < 0x80) {
+        ++*counter;
+        return byte;
+    }
+    return getULEB128Long(begin, counter);
+}
 
 /**
  * @brief Reads a signed LEB128 integer from the given memory at the given
@@ -49,6 +81,44 @@ uint64_t getULEB128(const void* begin, size_t* counter);
  * @param counter the memory position
  * @return the deducted number
  */
-int64_t getLEB128(const void* begin, size_t* counter);
+static inline int64_t getLEB128(const void* begin, size_t* counter) {
+    const uint8_t byte = *((const uint8_t*) begin + *counter);
+    if (byte < 0x80) {
+        ++*counter;
+        // Sign-extends the seven bits.
+        return (int64_t) (byte ^ 0x40) - 0x40;
+    }
+    return getLEB128Long(begin, counter);
+}
+
+/**
+ * @brief Reads an unsigned LEB128 integer from the given memory at the given
+ * position, not reading beyond the given size.
+ *
+ * The given memory position points to the first byte after the read number
+ * if it was read completely, it is left untouched otherwise.
+ *
+ * @param begin the memory pointer
+ * @param size the size of the memory
+ * @param counter the memory position
+ * @param result set to the deducted number
+ * @return whether the number was read completely
+ */
+bool getULEB128Bounded(const void* begin, size_t size, size_t* counter, uint64_t* result);
+
+/**
+ * @brief Reads a signed LEB128 integer from the given memory at the given
+ * position, not reading beyond the given size.
+ *
+ * The given memory position points to the first byte after the read number
+ * if it was read completely, it is left untouched otherwise.
+ *
+ * @param begin the memory pointer
+ * @param size the size of the memory
+ * @param counter the memory position
+ * @param result set to the deducted number
+ * @return whether the number was read completely
+ */
+bool getLEB128Bounded(const void* begin, size_t size, size_t* counter, int64_t* result);
 
 #endif /* leb128_h */
@@ -34,11 +34,11 @@
  * Unavailable fields are set to @c 0 and @c NULL, respectively.
  */
 struct dwarf_sourceFile {
-    /** The allocated source file name.          */
+    /** The source file name.                    */
     const char* fileName;
-    /** The allocated relative source file name. */
+    /** The relative source file name.           */
     const char* fileNameRelative;
-    /** The allocated absolute source file name. */
+    /** The absolute source file name.           */
     const char* fileNameAbsolute;
     /** The timestamp of the last modification.  */
     uint64_t timestamp;
@@ -76,26 +76,6 @@ struct dwarf_lineInfo {
     bool epilogueBegin;
 };
 
-/**
- * Destroys the given DWARF file info, passed by value.
- *
- * @param self the line info to be destroyed
- */
-static inline void dwarf_lineInfo_destroyValue(const struct dwarf_lineInfo self) {
-    free((void*) self.sourceFile.fileName);
-    free((void*) self.sourceFile.fileNameRelative);
-    free((void*) self.sourceFile.fileNameAbsolute);
-}
-
-/**
- * Destroys the given DWARF line info.
- *
- * @param self the line info to be destroyed
- */
-static inline void dwarf_lineInfo_destroy(const struct dwarf_lineInfo* self) {
-    dwarf_lineInfo_destroyValue(*self);
-}
-
-typedef_vector_named(dwarfLineInfo, struct dwarf_lineInfo);
+typedef_vector_named(dwarfSourceFile, struct dwarf_sourceFile);
 
 #endif /* dwarfLineInfo_h */
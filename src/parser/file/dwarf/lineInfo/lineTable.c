@@ -0,0 +1,258 @@
+/*
+ * CallstackLibrary - Library creating human-readable call stacks.
+ *
+ * Copyright (C) 2026  mhahnFr
+ *
+ * This file is part of the CallstackLibrary.
+ *
+ * The CallstackLibrary is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The CallstackLibrary is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with the
+ * CallstackLibrary, see the file LICENSE.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "lineTable.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/** The initial capacity of the hash index of the file table. */
+#define DWARF_LINE_TABLE_INDEX_CAPACITY 64
+
+/**
+ * Hashes the given source file name.
+ *
+ * @param fileName the source file name
+ * @return the hash value
+ */
+static inline uint64_t dwarf_lineTable_hash(const char* fileName) {
+    uint64_t hash = UINT64_C(0xcbf29ce484222325);
+    for (; *fileName != '\0'; ++fileName) {
+        hash ^= (unsigned char) *fileName;
+        hash *= UINT64_C(0x100000001b3);
+    }
+    return hash;
+}
+
+/**
+ * Returns the slot of the hash index of the given line table the given source
+ * file name is stored in or would be stored in.
+ *
+ * @param self the line table
+ * @param fileName the source file name
+ * @return the slot in the hash index
+ */
+static inline size_t dwarf_lineTable_slotOf(const struct dwarf_lineTable* self, const char* fileName) {
+    const size_t mask = self->fileIndexCapacity - 1;
+    size_t slot = (size_t) dwarf_lineTable_hash(fileName) & mask;
+    while (self->fileIndex[slot] != 0
+           && strcmp(self->files.content[self->fileIndex[slot] - 1].fileName, fileName) != 0) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+/**
+ * @brief Doubles the capacity of the hash index of the file table of the given
+ * line table.
+ *
+ * @param self the line table
+ * @return whether the hash index could be grown
+ */
+static inline bool dwarf_lineTable_growIndex(struct dwarf_lineTable* self) {
+    const size_t capacity = self->fileIndexCapacity == 0 ? DWARF_LINE_TABLE_INDEX_CAPACITY
+                                                         : self->fileIndexCapacity * 2;
+    uint32_t* index = calloc(capacity, sizeof(uint32_t));
+    if (index == NULL) return false;
+
+    free(self->fileIndex);
+    self->fileIndex         = index;
+    self->fileIndexCapacity = capacity;
+    for (size_t i = 0; i < self->files.count; ++i) {
+        index[dwarf_lineTable_slotOf(self, self->files.content[i].fileName)] = (uint32_t) (i + 1);
+    }
+    return true;
+}
+
+/**
+ * @brief Returns the index of the given source file in the file table of the
+ * given line table.
+ *
+ * A copy of the source file is added if not found.
+ *
+ * @param self the line table
+ * @param file the source file
+ * @return the index of the source file or @c DWARF_LINE_TABLE_NO_ENTRY_FILE
+ */
+static inline uint32_t dwarf_lineTable_internFile(struct dwarf_lineTable* self, const struct dwarf_sourceFile file) {
+    if (file.fileName == NULL || self->files.count >= DWARF_LINE_TABLE_NO_ENTRY_FILE - 1) {
+        return DWARF_LINE_TABLE_NO_ENTRY_FILE;
+    }
+    // The hash index is kept at most half full.
+    if ((self->files.count + 1) * 2 > self->fileIndexCapacity && !dwarf_lineTable_growIndex(self)) {
+        return DWARF_LINE_TABLE_NO_ENTRY_FILE;
+    }
+    const size_t slot = dwarf_lineTable_slotOf(self, file.fileName);
+    if (self->fileIndex[slot] != 0) {
+        return self->fileIndex[slot] - 1;
+    }
+    const struct dwarf_sourceFile copy = {
+        strdup(file.fileName), NULL, NULL, file.timestamp, file.size
+    };
+    if (copy.fileName == NULL || !vector_push_back(&self->files, copy)) {
+        free((void*) copy.fileName);
+        return DWARF_LINE_TABLE_NO_ENTRY_FILE;
+    }
+    self->fileIndex[slot] = (uint32_t) self->files.count;
+    return (uint32_t) (self->files.count - 1);
+}
+
+void dwarf_lineTable_add(const struct dwarf_lineInfo* infos, const size_t count, void* args) {
+    struct dwarf_lineTable* self = args;
+
+    // The rows of a batch come from the same line program, sharing the strings of the same source file.
+    const char* lastName = NULL;
+    uint32_t lastFile = DWARF_LINE_TABLE_NO_ENTRY_FILE;
+    for (size_t i = 0; i < count; ++i) {
+        const struct dwarf_lineInfo* info = &infos[i];
+        if (info->sourceFile.fileName == NULL || info->sourceFile.fileName != lastName) {
+            lastName = info->sourceFile.fileName;
+            lastFile = dwarf_lineTable_internFile(self, info->sourceFile);
+        }
+        vector_push_back(&self->pending, ((struct dwarf_lineEntry) {
+            .address     = info->address,
+            .line        = info->line > UINT32_MAX ? UINT32_MAX : (uint32_t) info->line,
+            .order       = (uint32_t) self->pending.count,
+            .file        = lastFile,
+            .column      = info->column > UINT16_MAX ? UINT16_MAX : (uint16_t) info->column,
+            .endSequence = info->endSequence,
+        }));
+    }
+}
+
+/**
+ * @brief Compares the two given pending rows.
+ *
+ * Of the rows sharing an address, the ends of sequences come first, the
+ * others in the order they were added.
+ *
+ * @param lhs the left-hand side row
+ * @param rhs the right-hand side row
+ * @return a value smaller, equal to or greater than @c 0 according to the sorting order
+ */
+static inline int dwarf_lineTable_entryCompare(const void* lhs, const void* rhs) {
+    const struct dwarf_lineEntry* a = lhs,
+                                * b = rhs;
+    if (a->address < b->address) return -1;
+    if (a->address > b->address) return +1;
+    if (a->endSequence != b->endSequence) return a->endSequence ? -1 : +1;
+    if (a->order < b->order) return -1;
+    if (a->order > b->order) return +1;
+    return 0;
+}
+
+/**
+ * Returns whether the given pending row can be stored relatively to the given run.
+ *
+ * @param run the run
+ * @param entry the pending row
+ * @return whether the row fits into the run
+ */
+static inline bool dwarf_lineTable_fitsRun(const struct dwarf_lineRun* run, const struct dwarf_lineEntry* entry) {
+    return entry->address - run->base <= UINT32_MAX
+        && (entry->file == DWARF_LINE_TABLE_NO_ENTRY_FILE
+            || (entry->file >= run->fileBase && entry->file - run->fileBase < DWARF_LINE_TABLE_NO_FILE));
+}
+
+void dwarf_lineTable_compact(struct dwarf_lineTable* self) {
+    if (self->pending.count > 0) {
+        vector_sort(&self->pending, dwarf_lineTable_entryCompare);
+    }
+    vector_destroy(&self->rows);
+    vector_init(&self->rows);
+    vector_destroy(&self->runs);
+    vector_init(&self->runs);
+    if (self->pending.count > 0 && vector_reserve(&self->rows, self->pending.count)) {
+        const struct dwarf_lineRun* run = NULL;
+        for (size_t i = 0; i < self->pending.count; ++i) {
+            const struct dwarf_lineEntry* entry = &self->pending.content[i];
+            // The last row of an address is the one in effect for it. Rows sharing the position of
+            // the previous row are kept nonetheless: Their address bounds the function they belong to.
+            if (i + 1 < self->pending.count && self->pending.content[i + 1].address == entry->address) {
+                continue;
+            }
+            if (run == NULL || !dwarf_lineTable_fitsRun(run, entry)) {
+                size_t fileBase = run == NULL ? 0 : run->fileBase;
+                if (entry->file != DWARF_LINE_TABLE_NO_ENTRY_FILE
+                    && (entry->file < fileBase || entry->file - fileBase >= DWARF_LINE_TABLE_NO_FILE)) {
+                    // Centered, since neighbouring rows mostly refer to neighbouring files.
+                    fileBase = entry->file < DWARF_LINE_TABLE_NO_FILE / 2 ? 0
+                                                                          : entry->file - DWARF_LINE_TABLE_NO_FILE / 2;
+                }
+                if (!vector_push_back(&self->runs, ((struct dwarf_lineRun) {
+                    entry->address, self->rows.count, fileBase
+                }))) {
+                    break;
+                }
+                run = &self->runs.content[self->runs.count - 1];
+            }
+            vector_push_back(&self->rows, ((struct dwarf_lineRow) {
+                (uint32_t) (entry->address - run->base), entry->line, entry->column,
+                entry->file == DWARF_LINE_TABLE_NO_ENTRY_FILE ? DWARF_LINE_TABLE_NO_FILE
+                                                              : (uint16_t) (entry->file - run->fileBase)
+            }));
+        }
+    }
+    vector_destroy(&self->pending);
+    vector_init(&self->pending);
+}
+
+const struct dwarf_lineRow* dwarf_lineTable_find(const struct dwarf_lineTable* self, const uint64_t address) {
+    size_t low = 0, high = self->runs.count;
+    while (low < high) {
+        const size_t middle = low + (high - low) / 2;
+        if (self->runs.content[middle].base < address) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    if (low == 0) {
+        return NULL;
+    }
+    // The first row of the run is at its base, below the address.
+    const struct dwarf_lineRun* run = &self->runs.content[low - 1];
+    const uint64_t delta = address - run->base;
+    high = low < self->runs.count ? self->runs.content[low].first : self->rows.count;
+    low  = run->first;
+    while (low < high) {
+        const size_t middle = low + (high - low) / 2;
+        if (self->rows.content[middle].addressDelta < delta) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return &self->rows.content[low - 1];
+}
+
+void dwarf_lineTable_destroy(struct dwarf_lineTable* self) {
+    vector_iterate(&self->files, {
+        free((void*) element->fileName);
+        free((void*) element->fileNameRelative);
+        free((void*) element->fileNameAbsolute);
+    });
+    vector_destroy(&self->files);
+    free(self->fileIndex);
+    vector_destroy(&self->runs);
+    vector_destroy(&self->rows);
+    vector_destroy(&self->pending);
+}
@@ -0,0 +1,208 @@
+/*
+ * CallstackLibrary - Library creating human-readable call stacks.
+ *
+ * Copyright (C) 2026  mhahnFr
+ *
+ * This file is part of the CallstackLibrary.
+ *
+ * The CallstackLibrary is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The CallstackLibrary is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with the
+ * CallstackLibrary, see the file LICENSE.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef dwarfLineTable_h
+#define dwarfLineTable_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <DC4C/vector.h>
+
+#include "lineInfo.h"
+
+/** The file index of rows not referring to a source file. */
+#define DWARF_LINE_TABLE_NO_FILE UINT16_MAX
+
+/**
+ * This structure represents a compact row of a line table.
+ */
+struct dwarf_lineRow {
+    /** The address relative to the base address of its run.   */
+    uint32_t addressDelta;
+    /** The line number.                                       */
+    uint32_t line;
+    /** The column number.                                     */
+    uint16_t column;
+    /** The index of the source file relative to its run.      */
+    uint16_t file;
+};
+
+/**
+ * @brief This structure represents a run of consecutive rows of a line table.
+ *
+ * The rows store their address and their source file relative to their run;
+ * a new run is started whenever a row cannot be stored relatively to the
+ * current one.
+ */
+struct dwarf_lineRun {
+    /** The address the addresses of the rows are relative to. */
+    uint64_t base;
+    /** The index of the first row of the run.                 */
+    size_t first;
+    /** The index the file indices of the rows are relative to. */
+    size_t fileBase;
+};
+
+/**
+ * This structure represents a row added to a line table but not yet compacted.
+ */
+struct dwarf_lineEntry {
+    /** The address.                                            */
+    uint64_t address;
+    /** The line number.                                        */
+    uint32_t line;
+    /** The position in which the row has been added.           */
+    uint32_t order;
+    /** The index of the source file in the file table.         */
+    uint32_t file;
+    /** The column number.                                      */
+    uint16_t column;
+    /** Whether the row is the end of a sequence.               */
+    bool endSequence;
+};
+
+typedef_vector_named(dwarfLineRow, struct dwarf_lineRow);
+typedef_vector_named(dwarfLineRun, struct dwarf_lineRun);
+typedef_vector_named(dwarfLineEntry, struct dwarf_lineEntry);
+
+/** The file index of pending rows not referring to a source file. */
+#define DWARF_LINE_TABLE_NO_ENTRY_FILE UINT32_MAX
+
+/**
+ * @brief This structure represents a line table.
+ *
+ * The rows are added while the line programs are parsed and compacted
+ * afterwards. The source files are stored once in the file table, found by
+ * their name using a hash index.
+ */
+struct dwarf_lineTable {
+    /** The runs of the compacted rows, sorted ascendingly.     */
+    vector_dwarfLineRun_t runs;
+    /** The compacted rows, sorted ascendingly by address.      */
+    vector_dwarfLineRow_t rows;
+    /** The source files referred to by the rows.               */
+    vector_dwarfSourceFile_t files;
+    /** The hash index of the file table: file indices plus one, @c 0 if empty. */
+    uint32_t* fileIndex;
+    /** The capacity of the hash index, a power of two or @c 0. */
+    size_t fileIndexCapacity;
+    /** The rows added but not yet compacted.                   */
+    vector_dwarfLineEntry_t pending;
+};
+
+/** Initializes an empty line table. */
+#define dwarf_lineTable_initializer { \
+    vector_initializer, vector_initializer, vector_initializer, NULL, 0, vector_initializer \
+}
+
+/**
+ * @brief Adds the given emitted line table rows to the given line table.
+ *
+ * The source files of the rows are copied into the file table if not yet
+ * present.<br>
+ * Usable as callback function for the DWARF line program parser.
+ *
+ * @param infos the emitted line table rows
+ * @param count the number of the rows
+ * @param self the line table, as payload of the DWARF parser
+ */
+void dwarf_lineTable_add(const struct dwarf_lineInfo* infos, size_t count, void* self);
+
+/**
+ * @brief Compacts the rows added to the given line table.
+ *
+ * The rows are sorted, of the rows sharing an address only the one in effect
+ * for it is kept. Rows repeating the position of their predecessor are kept,
+ * since the address of the row found for an address is checked to lie within
+ * the function of that address; merging them would move it below the start of
+ * the function. New runs are started for rows too far away from the current
+ * run, no row is dropped.
+ *
+ * @param self the line table
+ */
+void dwarf_lineTable_compact(struct dwarf_lineTable* self);
+
+/**
+ * Returns the row with the highest address below the given address.
+ *
+ * @param self the compacted line table
+ * @param address the address
+ * @return the found row or @c NULL if not found
+ */
+const struct dwarf_lineRow* dwarf_lineTable_find(const struct dwarf_lineTable* self, uint64_t address);
+
+/**
+ * Returns the run of the given row of the given line table.
+ *
+ * @param self the compacted line table
+ * @param row the row
+ * @return the run of the row
+ */
+static inline const struct dwarf_lineRun* dwarf_lineTable_runOf(const struct dwarf_lineTable* self,
+                                                                const struct dwarf_lineRow* row) {
+    const size_t index = (size_t) (row - self->rows.content);
+    size_t low = 1, high = self->runs.count;
+    while (low < high) {
+        const size_t middle = low + (high - low) / 2;
+        if (self->runs.content[middle].first <= index) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return &self->runs.content[low - 1];
+}
+
+/**
+ * Returns the address of the given row of the given line table.
+ *
+ * @param self the line table
+ * @param row the row
+ * @return the address of the row
+ */
+static inline uint64_t dwarf_lineTable_address(const struct dwarf_lineTable* self, const struct dwarf_lineRow* row) {
+    return dwarf_lineTable_runOf(self, row)->base + row->addressDelta;
+}
+
+/**
+ * Returns the source file the given row refers to.
+ *
+ * @param self the line table
+ * @param row the row
+ * @return the source file or @c NULL if the row does not refer to one
+ */
+static inline struct dwarf_sourceFile* dwarf_lineTable_file(const struct dwarf_lineTable* self,
+                                                            const struct dwarf_lineRow* row) {
+    if (row->file == DWARF_LINE_TABLE_NO_FILE) {
+        return NULL;
+    }
+    return &self->files.content[dwarf_lineTable_runOf(self, row)->fileBase + row->file];
+}
+
+/**
+ * Destroys the given line table.
+ *
+ * @param self the line table to be destroyed
+ */
+void dwarf_lineTable_destroy(struct dwarf_lineTable* self);
+
+#endif /* dwarfLineTable_h */
@@ -28,24 +28,50 @@
 #include "../v3/definitions.h"
 #include "../v4/definitions.h"
 
-void dwarf_lineInfoParser_handleDefaultEntry(struct dwarf_lineInfoParser* self, const uint8_t opCode) {
-    const uint8_t adjustedOpCode = opCode - self->parser->opCodeBase;
-    if (self->parser->version > 3) {
-        const uint8_t operationAdvance = adjustedOpCode / self->parser->lineRange;
+/**
+ * @brief Appends the current state as row to the buffer of the main parser.
+ *
+ * The buffered rows are passed to the callback once the buffer is full.
+ *
+ * @param self the DWARF line information parser object
+ */
+static inline void dwarf_lineInfoParser_emitRow(struct dwarf_lineInfoParser* self) {
+    struct dwarf_parser* parser = self->parser;
 
-        self->address += self->parser->minimumInstructionLength
-                         * ((self->opIndex + operationAdvance) / self->parser->maximumOperationsPerInstruction);
-        self->opIndex  = (self->opIndex + operationAdvance) % self->parser->maximumOperationsPerInstruction;
+    parser->rows[parser->rowCount++] = (struct dwarf_lineInfo) {
+        self->address, self->line, self->column, self->isa, self->discriminator,
+        dwarf_parser_getSourceFile(parser, self->file),
+        self->isStmt, self->basicBlock, self->endSequence, self->prologueEnd, self->epilogueBegin
+    };
+    if (parser->rowCount == DWARF_LINE_BATCH_SIZE) {
+        dwarf_parser_flushRows(parser);
+    }
+}
+
+/**
+ * Advances the address and the operation index as the given special opcode does.
+ *
+ * @param self the DWARF line information parser object
+ * @param special the precomputed effect of the special opcode
+ */
+static inline void dwarf_lineInfoParser_advanceSpecial(struct dwarf_lineInfoParser* self,
+                                                       const struct dwarf_specialOpcode* special) {
+    if (self->parser->singleOperation) {
+        self->address += special->addressAdvance;
     } else {
-        self->address += adjustedOpCode / self->parser->lineRange * self->parser->minimumInstructionLength;
+        self->address += self->parser->minimumInstructionLength
+                         * ((self->opIndex + special->operationAdvance) / self->parser->maximumOperationsPerInstruction);
+        self->opIndex  = (self->opIndex + special->operationAdvance) % self->parser->maximumOperationsPerInstruction;
     }
-    self->line += self->parser->lineBase + adjustedOpCode % self->parser->lineRange;
+}
 
-    self->parser->cb((struct dwarf_lineInfo) {
-        self->address, self->line, self->column, self->isa, self->discriminator,
-        self->parser->getFileName(self->parser, self->file),
-        self->isStmt, self->basicBlock, self->endSequence, self->prologueEnd, self->epilogueBegin
-    }, self->parser->args);
+void dwarf_lineInfoParser_handleDefaultEntry(struct dwarf_lineInfoParser* self, const uint8_t opCode) {
+    const struct dwarf_specialOpcode* special = &self->parser->specialOpcodes[opCode];
+
+    dwarf_lineInfoParser_advanceSpecial(self, special);
+    self->line += special->lineAdvance;
+
+    dwarf_lineInfoParser_emitRow(self);
 
     self->basicBlock    = false;
     self->prologueEnd   = false;
@@ -59,11 +85,7 @@ void dwarf_lineInfoParser_handleDefaultEntry(struct dwarf_lineInfoParser* self,
  * @param self the DWARF line information parser object
  */
 static inline void dwarf_lineInfoParser_commandCopy(struct dwarf_lineInfoParser* self) {
-    self->parser->cb((struct dwarf_lineInfo) {
-        self->address, self->line, self->column, self->isa, self->discriminator,
-        self->parser->getFileName(self->parser, self->file),
-        self->isStmt, self->basicBlock, self->endSequence, self->prologueEnd, self->epilogueBegin
-    }, self->parser->args);
+    dwarf_lineInfoParser_emitRow(self);
 
     self->discriminator = 0;
     self->basicBlock = self->prologueEnd = self->epilogueBegin = false;
@@ -77,12 +99,12 @@ static inline void dwarf_lineInfoParser_commandCopy(struct dwarf_lineInfoParser*
  */
 static inline void dwarf_lineInfoParser_commandAdvance(struct dwarf_lineInfoParser* self, size_t* counter) {
     const uint64_t operationAdvance = getULEB128(self->parser->debugLine.content, counter);
-    if (self->parser->version > 3) {
+    if (self->parser->singleOperation) {
+        self->address += self->parser->minimumInstructionLength * operationAdvance;
+    } else {
         self->address += self->parser->minimumInstructionLength
                          * ((self->opIndex + operationAdvance) / self->parser->maximumOperationsPerInstruction);
         self->opIndex = (self->opIndex + operationAdvance) % self->parser->maximumOperationsPerInstruction;
-    } else {
-        self->address += self->parser->minimumInstructionLength * operationAdvance;
     }
 }
 
@@ -92,16 +114,7 @@ static inline void dwarf_lineInfoParser_commandAdvance(struct dwarf_lineInfoPars
  * @param self the DWARF line information parser
  */
 static inline void dwarf_lineInfoParser_commandAdd(struct dwarf_lineInfoParser* self) {
-    const uint8_t adjustedOpCode = 255 - self->parser->opCodeBase;
-    if (self->parser->version > 3) {
-        const uint8_t operationAdvance = adjustedOpCode / self->parser->lineRange;
-
-        self->address += self->parser->minimumInstructionLength
-                         * ((self->opIndex + operationAdvance) / self->parser->maximumOperationsPerInstruction);
-        self->opIndex  = (self->opIndex + operationAdvance) % self->parser->maximumOperationsPerInstruction;
-    } else {
-        self->address += adjustedOpCode / self->parser->lineRange * self->parser->minimumInstructionLength;
-    }
+    dwarf_lineInfoParser_advanceSpecial(self, &self->parser->specialOpcodes[255]);
 }
 
 /**
@@ -154,11 +167,7 @@ void dwarf_lineInfoParser_handleSingeInstruction(struct dwarf_lineInfoParser* se
  */
 static inline void dwarf_lineInfoParser_handleEndSequence(struct dwarf_lineInfoParser* self) {
     self->endSequence = true;
-    self->parser->cb((struct dwarf_lineInfo) {
-        self->address, self->line, self->column, self->isa, self->discriminator,
-        self->parser->getFileName(self->parser, self->file),
-        self->isStmt, self->basicBlock, self->endSequence, self->prologueEnd, self->epilogueBegin
-    }, self->parser->args);
+    dwarf_lineInfoParser_emitRow(self);
 
     self->address = self->opIndex = self->column = self->isa = self->discriminator = 0;
     self->basicBlock = self->endSequence = self->prologueEnd = self->epilogueBegin = false;
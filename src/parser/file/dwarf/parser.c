@@ -50,19 +50,82 @@ char* dwarf_pathConcatenate(const char* string1, const char* string2) {
     return toReturn;
 }
 
+struct dwarf_sourceFile dwarf_parser_getSourceFile(struct dwarf_parser* self, const uint64_t file) {
+    if (file < self->sourceFiles.count && self->sourceFiles.content[file].fileName != NULL) {
+        return self->sourceFiles.content[file];
+    }
+    const struct dwarf_sourceFile toReturn = self->getFileName(self, file);
+    if (toReturn.fileName == NULL) {
+        return toReturn;
+    }
+    if (file >= self->sourceFiles.count) {
+        if (!vector_reserve(&self->sourceFiles, file + 1)) {
+            free((void*) toReturn.fileName);
+            throw(failedAllocation, self, "Failed to allocate memory for the source files");
+        }
+        while (self->sourceFiles.count <= file) {
+            vector_push_back(&self->sourceFiles, ((struct dwarf_sourceFile) { NULL, NULL, NULL, 0, 0 }));
+        }
+    }
+    self->sourceFiles.content[file] = toReturn;
+    return toReturn;
+}
+
+/**
+ * Destroys the source files resolved by the given DWARF parser.
+ *
+ * @param self the DWARF parser structure
+ */
+static inline void dwarf_parser_destroySourceFiles(struct dwarf_parser* self) {
+    vector_iterate(&self->sourceFiles, {
+        free((void*) element->fileName);
+    });
+    vector_destroy(&self->sourceFiles);
+}
+
+void dwarf_parser_flushRows(struct dwarf_parser* self) {
+    if (self->rowCount > 0) {
+        self->cb(self->rows, self->rowCount, self->args);
+        self->rowCount = 0;
+    }
+}
+
+/**
+ * @brief Precomputes the effects of the special opcodes.
+ *
+ * Uses the values read from the line program header.
+ *
+ * @param self the DWARF parser object
+ */
+static inline void dwarf_parser_createSpecialOpcodes(struct dwarf_parser* self) {
+    self->singleOperation = self->version < 4 || self->maximumOperationsPerInstruction <= 1;
+    for (unsigned opCode = self->opCodeBase; opCode < 256; ++opCode) {
+        const uint8_t adjustedOpCode   = (uint8_t) (opCode - self->opCodeBase),
+                      operationAdvance = self->lineRange == 0 ? 0 : adjustedOpCode / self->lineRange;
+        self->specialOpcodes[opCode] = (struct dwarf_specialOpcode) {
+            .addressAdvance   = (uint32_t) operationAdvance * self->minimumInstructionLength,
+            .lineAdvance      = (int16_t) (self->lineBase + (self->lineRange == 0 ? 0 : adjustedOpCode % self->lineRange)),
+            .operationAdvance = operationAdvance,
+        };
+    }
+}
+
 /**
  * @brief This function parses the actual DWARF line program.
  *
- * The registered callback function is called for each line number table row
- * that is emitted.
+ * The registered callback function is called with the emitted line number
+ * table rows.
  *
  * @param self the DWARF parser object
  * @param counter the counter of already read bytes (offset)
  * @param actualSize the size of the line number program including the header,
  * as read from the header
+ * @return the section beginning with the following line program or an empty
+ * section if it is not to be parsed
  */
-static inline void dwarf_parser_parse(struct dwarf_parser* self, size_t counter, const size_t actualSize) {
+static inline struct lcs_section dwarf_parser_parse(struct dwarf_parser* self, size_t counter, const size_t actualSize) {
     self->parseHeader(self, &counter);
+    dwarf_parser_createSpecialOpcodes(self);
     struct dwarf_lineInfoParser parser = dwarf_lineInfoParser_initializer(self->defaultIsStmt, self);
     while (counter - (self->bit64 ? 12 : 4) < actualSize) {
         const uint8_t opCode = *(uint8_t*) (self->debugLine.content + counter++);
@@ -75,14 +138,15 @@ static inline void dwarf_parser_parse(struct dwarf_parser* self, size_t counter,
             dwarf_lineInfoParser_handleDefaultEntry(&parser, opCode);
         }
     }
-    
-    if (counter < self->debugLine.size - 2 - (self->bit64 ? 12 : 4)) {
-        dwarf_parseLineProgram((struct lcs_section) {
+    dwarf_parser_flushRows(self);
+
+    if (self->parseFollowing && counter < self->debugLine.size - 2 - (self->bit64 ? 12 : 4)) {
+        return (struct lcs_section) {
             self->debugLine.content + counter,
             self->debugLine.size - 2 - (self->bit64 ? 12 : 4) - counter
-        }, self->debugLineStr, self->debugStr, self->debugInfo, self->debugAbbrev, self->debugStrOffsets, self->fileName,
-        self->cb, self->args);
+        };
     }
+    return lcs_section_initializer;
 }
 
 /**
@@ -318,14 +382,15 @@ const char* dwarf_readString(const struct dwarf_parser* self, const void* buffer
 }
 
 /**
- * Parses the compilation directory.
+ * Parses the compilation directory of the given compilation unit.
  *
  * @param self the DWARF parser object
+ * @param unitOffset the offset of the compilation unit in the @c .debug_info section
  * @return whether the parsing was successful
  */
-static inline const char* dwarf_parseCompDir(struct dwarf_parser* self) {
+static inline const char* dwarf_parseCompDir(struct dwarf_parser* self, const uint64_t unitOffset) {
     bool bit64;
-    size_t counter = 0;
+    size_t counter = (size_t) unitOffset;
     const uint64_t size = dwarf_parseInitialSize(self->debugInfo.content, &counter, &bit64);
     const uint16_t version = *(uint16_t*) (self->debugInfo.content + counter);
     counter += 2;
@@ -399,14 +464,38 @@ static inline const char* dwarf_parseCompDir(struct dwarf_parser* self) {
     }))
 }
 
-void dwarf_parseLineProgram(const struct lcs_section debugLine,
-                            const struct lcs_section debugLineStr,
-                            const struct lcs_section debugStr,
-                            const struct lcs_section debugInfo,
-                            const struct lcs_section debugAbbrev,
-                            const struct lcs_section debugStrOffsets,
-                            const char* fileName,
-                            const dwarf_line_callback cb, void* args) {
+/**
+ * @brief Parses the line program at the beginning of the given section.
+ *
+ * Calls the callback with each emitted line table row and the given payload.
+ *
+ * @param debugLine the section corresponding to the @c .debug_line section,
+ * beginning with the line program to be parsed
+ * @param debugLineStr the section corresponding to the @c .debug_line_str section
+ * @param debugStr the section corresponding to the @c .debug_str section
+ * @param debugInfo the section corresponding to the @c .debug_info section
+ * @param debugAbbrev the section corresponding to the @c .debug_abbrev section
+ * @param debugStrOffsets the section corresponding to the @c .debug_str_offsets section
+ * @param unitOffset the offset of the compilation unit whose compilation directory is used
+ * @param parseFollowing whether to parse the following line programs as well
+ * @param fileName the name of the file currently being parsed
+ * @param cb the line table row callback
+ * @param args the payload to additionally pass to the callback function
+ * @param rows the buffer for the emitted rows, holding @c DWARF_LINE_BATCH_SIZE rows
+ * @return the section beginning with the following line program or an empty
+ * section if it is not to be parsed
+ */
+static inline struct lcs_section dwarf_parseLineProgramImpl(const struct lcs_section debugLine,
+                                              const struct lcs_section debugLineStr,
+                                              const struct lcs_section debugStr,
+                                              const struct lcs_section debugInfo,
+                                              const struct lcs_section debugAbbrev,
+                                              const struct lcs_section debugStrOffsets,
+                                              const uint64_t unitOffset,
+                                              const bool parseFollowing,
+                                              const char* fileName,
+                                              const dwarf_line_callback cb, void* args,
+                                              struct dwarf_lineInfo* rows) {
     bool bit64;
     size_t counter = 0;
     const uint64_t size = dwarf_parseInitialSize(debugLine.content, &counter, &bit64);
@@ -424,12 +513,16 @@ void dwarf_parseLineProgram(const struct lcs_section debugLine,
         .debugStrOffsets = debugStrOffsets,
         .cb = cb,
         .args = args,
+        .rows = rows,
+        .rowCount = 0,
         .stdOpcodeLengths = vector_initializer,
         .compilationDirectory = NULL,
         .debugStrOffset = (optional_uint64_t) { .has_value = false },
         .fileName = fileName,
+        .parseFollowing = parseFollowing,
+        .sourceFiles = vector_initializer,
     };
-    parser.compilationDirectory = dwarf_parseCompDir(&parser);
+    parser.compilationDirectory = dwarf_parseCompDir(&parser, unitOffset);
     switch (version) {
         case 2:
         case 3:
@@ -438,14 +531,55 @@ void dwarf_parseLineProgram(const struct lcs_section debugLine,
 
         default: throw(unsupported, &parser, "Unsupported DWARF version");
     }
+    struct lcs_section following;
     TRY({
-        dwarf_parser_parse(&parser, counter, size);
+        following = dwarf_parser_parse(&parser, counter, size);
     }, CATCH_ALL(_, {
         (void) _;
+        dwarf_parser_flushRows(&parser);
+        dwarf_parser_destroySourceFiles(&parser);
         vector_destroy(&parser.stdOpcodeLengths);
         parser.destroy(&parser);
         RETHROW;
     }))
+    dwarf_parser_destroySourceFiles(&parser);
     vector_destroy(&parser.stdOpcodeLengths);
     parser.destroy(&parser);
-}
\ No newline at end of file
+    return following;
+}
+
+void dwarf_parseLineProgram(const struct lcs_section debugLine,
+                            const struct lcs_section debugLineStr,
+                            const struct lcs_section debugStr,
+                            const struct lcs_section debugInfo,
+                            const struct lcs_section debugAbbrev,
+                            const struct lcs_section debugStrOffsets,
+                            const char* fileName,
+                            const dwarf_line_callback cb, void* args) {
+    struct dwarf_lineInfo rows[DWARF_LINE_BATCH_SIZE];
+    struct lcs_section program = debugLine;
+    do {
+        program = dwarf_parseLineProgramImpl(program, debugLineStr, debugStr, debugInfo, debugAbbrev, debugStrOffsets, 0,
+                                             true, fileName, cb, args, rows);
+    } while (program.size > 0);
+}
+
+void dwarf_parseUnitLineProgram(const struct lcs_section debugLine,
+                                const struct lcs_section debugLineStr,
+                                const struct lcs_section debugStr,
+                                const struct lcs_section debugInfo,
+                                const struct lcs_section debugAbbrev,
+                                const struct lcs_section debugStrOffsets,
+                                const uint64_t unitOffset,
+                                const uint64_t programOffset,
+                                const char* fileName,
+                                const dwarf_line_callback cb, void* args) {
+    if (unitOffset >= debugInfo.size || programOffset >= debugLine.size) {
+        BFE_THROW_RAW(invalid, fileName, "Invalid line program offset");
+    }
+    struct dwarf_lineInfo rows[DWARF_LINE_BATCH_SIZE];
+    dwarf_parseLineProgramImpl((struct lcs_section) {
+        debugLine.content + programOffset,
+        debugLine.size - programOffset
+    }, debugLineStr, debugStr, debugInfo, debugAbbrev, debugStrOffsets, unitOffset, false, fileName, cb, args, rows);
+}
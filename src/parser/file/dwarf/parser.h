@@ -23,6 +23,7 @@
 #define dwarf_parser_h
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <misc/numberContainers.h>
 
@@ -31,12 +32,29 @@
 #include "v4/parser.h"
 #include "v5/parser.h"
 
+/** The maximum number of line table rows passed to the line callback at once. */
+#define DWARF_LINE_BATCH_SIZE 64
+
 /**
  * @brief This type represents the function called by @c dwarf_parseLineProgram .
  *
- * It takes a DWARF line info structure and the additionally passed arguments.
+ * It takes the emitted DWARF line table rows, their count and the additionally
+ * passed arguments. The rows and the strings of the referred source files are
+ * owned by the parser and only valid during the call.
+ */
+typedef void (*dwarf_line_callback)(const struct dwarf_lineInfo*, size_t, void*);
+
+/**
+ * This structure represents the effect of a special opcode of a line program.
  */
-typedef void (*dwarf_line_callback)(struct dwarf_lineInfo, void*);
+struct dwarf_specialOpcode {
+    /** The advance of the address if instructions consist of a single operation. */
+    uint32_t addressAdvance;
+    /** The advance of the line number.                                           */
+    int16_t lineAdvance;
+    /** The advance of the operation index.                                       */
+    uint8_t operationAdvance;
+};
 
 /**
  * This structure represents a generified DWARF parser.
@@ -59,6 +77,10 @@ struct dwarf_parser {
             minimumInstructionLength;
     /** The line base value.                                                            */
     int8_t lineBase;
+    /** Whether each instruction consists of a single operation.                        */
+    bool singleOperation;
+    /** The effects of the special opcodes, indexed by the opcode.                      */
+    struct dwarf_specialOpcode specialOpcodes[256];
 
     /** Vector with the argument count of the standard op codes.                        */
     vector_uint8_t stdOpcodeLengths;
@@ -80,6 +102,10 @@ struct dwarf_parser {
     dwarf_line_callback cb;
     /** The payload for the DWARF line callback.                                        */
     void* args;
+    /** The buffer of the rows not yet passed to the callback.                          */
+    struct dwarf_lineInfo* rows;
+    /** The number of the rows in the buffer.                                           */
+    size_t rowCount;
 
     /** The name of the file currently being parsed.                                    */
     const char* fileName;
@@ -87,6 +113,10 @@ struct dwarf_parser {
     const char* compilationDirectory;
     /** The main offset into the debug string offsets table.                            */
     optional_uint64_t debugStrOffset;
+    /** Whether the line programs following the parsed one are parsed as well.          */
+    bool parseFollowing;
+    /** The source files resolved so far, indexed by their file index.                   */
+    vector_dwarfSourceFile_t sourceFiles;
 
     /** The function to destroy the version dependent part of this parser.              */
     void                    (*destroy)    (const struct dwarf_parser*);
@@ -128,6 +158,52 @@ void dwarf_parseLineProgram(struct lcs_section debugLine,
                             const char* fileName,
                             dwarf_line_callback cb, void* args);
 
+/**
+ * @brief Parses the line program of a single compilation unit.
+ *
+ * Calls the callback with each emitted line table row and the given payload.
+ *
+ * @param debugLine the section corresponding to the @c .debug_line section
+ * @param debugLineStr the section corresponding to the @c .debug_line_str section
+ * @param debugStr the section corresponding to the @c .debug_str section
+ * @param debugInfo the section corresponding to the @c .debug_info section
+ * @param debugAbbrev the section corresponding to the @c .debug_abbrev section
+ * @param debugStrOffsets the section corresponding to the @c .debug_str_offsets section
+ * @param unitOffset the offset of the compilation unit in the @c .debug_info section
+ * @param programOffset the offset of its line program in the @c .debug_line section
+ * @param fileName the name of the file currently being parsed
+ * @param cb the line table row callback
+ * @param args the payload to additionally pass to the callback function
+ */
+void dwarf_parseUnitLineProgram(struct lcs_section debugLine,
+                                struct lcs_section debugLineStr,
+                                struct lcs_section debugStr,
+                                struct lcs_section debugInfo,
+                                struct lcs_section debugAbbrev,
+                                struct lcs_section debugStrOffsets,
+                                uint64_t unitOffset,
+                                uint64_t programOffset,
+                                const char* fileName,
+                                dwarf_line_callback cb, void* args);
+
+/**
+ * Passes the buffered line table rows to the line callback.
+ *
+ * @param self the DWARF parser structure
+ */
+void dwarf_parser_flushRows(struct dwarf_parser* self);
+
+/**
+ * @brief Returns the source file reference for the given file index.
+ *
+ * The path of each file is constructed once per line program.
+ *
+ * @param self the DWARF parser structure
+ * @param file the index of the desired file
+ * @return the source file reference, owned by the parser
+ */
+struct dwarf_sourceFile dwarf_parser_getSourceFile(struct dwarf_parser* self, uint64_t file);
+
 /**
  * Concatenates the two given strings as paths.
  *
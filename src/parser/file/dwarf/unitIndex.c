@@ -0,0 +1,708 @@
+/*
+ * CallstackLibrary - Library creating human-readable call stacks.
+ *
+ * Copyright (C) 2026  mhahnFr
+ *
+ * This file is part of the CallstackLibrary.
+ *
+ * The CallstackLibrary is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The CallstackLibrary is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with the
+ * CallstackLibrary, see the file LICENSE.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "unitIndex.h"
+
+#include <string.h>
+#include <try_catch.h>
+
+#include "leb128.h"
+#include "parser.h"
+#include "../dc4c_exceptions.h"
+#include "../exception.h"
+#include "v5/definitions.h"
+
+/**
+ * Throws an exception with the given code and meta information.
+ *
+ * @param code the exception code
+ * @param self the pointer to the sections of the unit index being built
+ * @param message the message
+ */
+#define throw(code, self, message) BFE_THROW_RAW(code, (self)->fileName, message)
+
+/**
+ * The sections the unit index is built from.
+ */
+struct dwarf_unitIndex_sections {
+    /** The @c .debug_info section.     */
+    struct lcs_section debugInfo,
+    /** The @c .debug_abbrev section.   */
+                       debugAbbrev,
+    /** The @c .debug_aranges section.  */
+                       debugAranges,
+    /** The @c .debug_ranges section.   */
+                       debugRanges,
+    /** The @c .debug_rnglists section. */
+                       debugRnglists,
+    /** The @c .debug_addr section.     */
+                       debugAddr;
+
+    /** The name of the file currently being parsed. */
+    const char* fileName;
+};
+
+/**
+ * Represents an attribute value of a compilation unit entry.
+ */
+struct dwarf_unitIndex_value {
+    /** Whether the attribute is present.                         */
+    bool present;
+    /** The form of the attribute.                                */
+    uint64_t form;
+    /** The read constant, address, offset or index.             */
+    uint64_t value;
+};
+
+/**
+ * The header and the attributes of a compilation unit needed for its ranges.
+ */
+struct dwarf_unitIndex_unit {
+    /** The DWARF version of the compilation unit.   */
+    uint16_t version;
+    /** Whether the 64 Bit format is used.           */
+    bool bit64;
+    /** The size of an address in bytes.             */
+    uint8_t addressSize;
+
+    /** The @c DW_AT_stmt_list attribute.            */
+    struct dwarf_unitIndex_value stmtList,
+    /** The @c DW_AT_low_pc attribute.               */
+                                 lowPc,
+    /** The @c DW_AT_high_pc attribute.              */
+                                 highPc,
+    /** The @c DW_AT_ranges attribute.               */
+                                 ranges,
+    /** The @c DW_AT_addr_base attribute.            */
+                                 addrBase,
+    /** The @c DW_AT_rnglists_base attribute.        */
+                                 rnglistsBase;
+};
+
+typedef_vector_named(dwarfUnitIndexUnit, struct dwarf_unitIndex_unit);
+
+/**
+ * Reads an unsigned integer of the given size.
+ *
+ * @param self the sections of the unit index
+ * @param buffer the data buffer
+ * @param counter the reading index
+ * @param size the size of the integer in bytes
+ * @return the read integer
+ */
+static inline uint64_t dwarf_unitIndex_readSized(const struct dwarf_unitIndex_sections* self, const void* buffer,
+                                                 size_t* counter, const uint8_t size) {
+    uint64_t toReturn;
+    switch (size) {
+        case 1: toReturn = *(uint8_t*) (buffer + *counter);  break;
+        case 2: toReturn = *(uint16_t*) (buffer + *counter); break;
+        case 4: toReturn = *(uint32_t*) (buffer + *counter); break;
+        case 8: toReturn = *(uint64_t*) (buffer + *counter); break;
+
+        case 3:
+            toReturn = *(uint8_t*) (buffer + *counter)
+                     | (uint64_t) *(uint8_t*) (buffer + *counter + 1) << 8
+                     | (uint64_t) *(uint8_t*) (buffer + *counter + 2) << 16;
+            break;
+
+        default: throw(unsupported, self, "Unsupported DWARF data size");
+    }
+    *counter += size;
+    return toReturn;
+}
+
+/**
+ * Reads an unsigned LEB128 integer not extending beyond the given section.
+ *
+ * @param self the sections of the unit index
+ * @param section the section to read in
+ * @param counter the reading index
+ * @return the read integer
+ */
+static inline uint64_t dwarf_unitIndex_readULEB128(const struct dwarf_unitIndex_sections* self,
+                                                   const struct lcs_section section, size_t* counter) {
+    uint64_t toReturn;
+    if (!getULEB128Bounded(section.content, section.size, counter, &toReturn)) {
+        throw(invalid, self, "Truncated LEB128 number");
+    }
+    return toReturn;
+}
+
+/**
+ * Reads a signed LEB128 integer not extending beyond the given section.
+ *
+ * @param self the sections of the unit index
+ * @param section the section to read in
+ * @param counter the reading index
+ * @return the read integer
+ */
+static inline int64_t dwarf_unitIndex_readLEB128(const struct dwarf_unitIndex_sections* self,
+                                                 const struct lcs_section section, size_t* counter) {
+    int64_t toReturn;
+    if (!getLEB128Bounded(section.content, section.size, counter, &toReturn)) {
+        throw(invalid, self, "Truncated LEB128 number");
+    }
+    return toReturn;
+}
+
+/**
+ * Reads the value of an attribute of the given form.
+ *
+ * @param self the sections of the unit index
+ * @param unit the compilation unit the attribute belongs to
+ * @param counter the reading index into the @c .debug_info section
+ * @param form the form of the attribute
+ * @param implicitConst the value of an implicit constant
+ * @return the read value; @c 0 for forms not representing a number
+ */
+static inline uint64_t dwarf_unitIndex_readValue(const struct dwarf_unitIndex_sections* self,
+                                                 const struct dwarf_unitIndex_unit* unit,
+                                                 size_t* counter, const uint64_t form, const int64_t implicitConst) {
+    const void* buffer = self->debugInfo.content;
+    switch (form) {
+        case DW_FORM_addr: return dwarf_unitIndex_readSized(self, buffer, counter, unit->addressSize);
+
+        case DW_FORM_flag:
+        case DW_FORM_data1:
+        case DW_FORM_ref1:
+        case DW_FORM_strx1:
+        case DW_FORM_addrx1: return dwarf_unitIndex_readSized(self, buffer, counter, 1);
+
+        case DW_FORM_data2:
+        case DW_FORM_ref2:
+        case DW_FORM_strx2:
+        case DW_FORM_addrx2: return dwarf_unitIndex_readSized(self, buffer, counter, 2);
+
+        case DW_FORM_strx3:
+        case DW_FORM_addrx3: return dwarf_unitIndex_readSized(self, buffer, counter, 3);
+
+        case DW_FORM_data4:
+        case DW_FORM_ref4:
+        case DW_FORM_ref_sup4:
+        case DW_FORM_strx4:
+        case DW_FORM_addrx4: return dwarf_unitIndex_readSized(self, buffer, counter, 4);
+
+        case DW_FORM_data8:
+        case DW_FORM_ref8:
+        case DW_FORM_ref_sig8:
+        case DW_FORM_ref_sup8: return dwarf_unitIndex_readSized(self, buffer, counter, 8);
+
+        case DW_FORM_strp:
+        case DW_FORM_line_strp:
+        case DW_FORM_strp_sup:
+        case DW_FORM_sec_offset:
+        case DW_FORM_GNU_ref_alt:
+        case DW_FORM_GNU_strp_alt: return dwarf_unitIndex_readSized(self, buffer, counter, unit->bit64 ? 8 : 4);
+
+        case DW_FORM_ref_addr:
+            return dwarf_unitIndex_readSized(self, buffer, counter,
+                                             unit->version <= 2 ? unit->addressSize : unit->bit64 ? 8 : 4);
+
+        case DW_FORM_udata:
+        case DW_FORM_ref_udata:
+        case DW_FORM_strx:
+        case DW_FORM_addrx:
+        case DW_FORM_loclistx:
+        case DW_FORM_rnglistx:
+        case DW_FORM_GNU_addr_index:
+        case DW_FORM_GNU_str_index: return getULEB128(buffer, counter);
+
+        case DW_FORM_sdata:          return (uint64_t) getLEB128(buffer, counter);
+        case DW_FORM_implicit_const: return (uint64_t) implicitConst;
+        case DW_FORM_flag_present:   return 1;
+
+        case DW_FORM_data16: *counter += 16; return 0;
+
+        case DW_FORM_string: *counter += strlen(buffer + *counter) + 1; return 0;
+
+        case DW_FORM_block:
+        case DW_FORM_exprloc: {
+            const uint64_t length = getULEB128(buffer, counter);
+            *counter += length;
+            return 0;
+        }
+
+        case DW_FORM_block1:
+        case DW_FORM_block2:
+        case DW_FORM_block4: {
+            const uint64_t length = dwarf_unitIndex_readSized(self, buffer, counter,
+                                                              form == DW_FORM_block1 ? 1 : form == DW_FORM_block2 ? 2 : 4);
+            *counter += length;
+            return 0;
+        }
+
+        default: throw(unsupported, self, "Unsupported DWARF attribute form");
+    }
+}
+
+/**
+ * Returns whether the given form refers to an entry of the @c .debug_addr section.
+ *
+ * @param form the form to check
+ * @return whether the value of the form is an index
+ */
+static inline bool dwarf_unitIndex_isAddressIndex(const uint64_t form) {
+    return form == DW_FORM_addrx || form == DW_FORM_addrx1 || form == DW_FORM_addrx2 || form == DW_FORM_addrx3
+        || form == DW_FORM_addrx4 || form == DW_FORM_GNU_addr_index;
+}
+
+/**
+ * Loads the address at the given index of the address table of the given
+ * compilation unit.
+ *
+ * @param self the sections of the unit index
+ * @param unit the compilation unit
+ * @param index the index into the address table
+ * @return the loaded address
+ */
+static inline uint64_t dwarf_unitIndex_loadAddress(const struct dwarf_unitIndex_sections* self,
+                                                   const struct dwarf_unitIndex_unit* unit, const uint64_t index) {
+    // The default base skips the header of the first address table.
+    const uint64_t base = unit->addrBase.present ? unit->addrBase.value
+                                                 : unit->version >= 5 ? (unit->bit64 ? 16 : 8) : 0;
+    if (index >= self->debugAddr.size / unit->addressSize
+        || base > self->debugAddr.size - (index + 1) * unit->addressSize) {
+        throw(invalid, self, "Invalid address index");
+    }
+    size_t counter = (size_t) (base + index * unit->addressSize);
+    return dwarf_unitIndex_readSized(self, self->debugAddr.content, &counter, unit->addressSize);
+}
+
+/**
+ * Resolves the given address attribute value of the given compilation unit.
+ *
+ * @param self the sections of the unit index
+ * @param unit the compilation unit
+ * @param value the address attribute value
+ * @return the address
+ */
+static inline uint64_t dwarf_unitIndex_resolveAddress(const struct dwarf_unitIndex_sections* self,
+                                                      const struct dwarf_unitIndex_unit* unit,
+                                                      const struct dwarf_unitIndex_value value) {
+    return dwarf_unitIndex_isAddressIndex(value.form) ? dwarf_unitIndex_loadAddress(self, unit, value.value)
+                                                      : value.value;
+}
+
+/**
+ * @brief Adds the given address range of the given compilation unit.
+ *
+ * Empty ranges and the ranges of discarded code, starting at zero, are
+ * ignored.
+ *
+ * @param self the unit index
+ * @param begin the beginning of the range
+ * @param end the end of the range
+ * @param unit the index of the compilation unit
+ */
+static inline void dwarf_unitIndex_addRange(struct dwarf_unitIndex* self, const uint64_t begin, const uint64_t end,
+                                            const size_t unit) {
+    if (begin == 0 || end <= begin) return;
+
+    vector_push_back_throw(&self->ranges, ((struct dwarf_unitRange) { begin, end, unit }));
+    self->units.content[unit].indexed = true;
+}
+
+/**
+ * Searches the abbreviation of the given code.
+ *
+ * @param self the sections of the unit index
+ * @param offset the offset of the abbreviation table
+ * @param code the abbreviation code
+ * @param tag set to the tag of the abbreviation
+ * @return the offset of the attribute specifications of the abbreviation
+ */
+static inline size_t dwarf_unitIndex_findAbbreviation(const struct dwarf_unitIndex_sections* self,
+                                                      const uint64_t offset, const uint64_t code, uint64_t* tag) {
+    size_t counter = (size_t) offset;
+    while (counter < self->debugAbbrev.size) {
+        const uint64_t current = dwarf_unitIndex_readULEB128(self, self->debugAbbrev, &counter);
+        if (current == 0) break;
+
+        *tag = dwarf_unitIndex_readULEB128(self, self->debugAbbrev, &counter);
+        ++counter;
+        if (current == code) {
+            return counter;
+        }
+        uint64_t name, form;
+        do {
+            name = dwarf_unitIndex_readULEB128(self, self->debugAbbrev, &counter);
+            form = dwarf_unitIndex_readULEB128(self, self->debugAbbrev, &counter);
+            if (form == DW_FORM_implicit_const) {
+                dwarf_unitIndex_readLEB128(self, self->debugAbbrev, &counter);
+            }
+        } while (name != 0 || form != 0);
+    }
+    throw(invalid, self, "Abbreviation of compilation unit not found");
+}
+
+/**
+ * Parses the entry of the compilation unit starting at the given offset.
+ *
+ * @param self the sections of the unit index
+ * @param counter the reading index, set behind the compilation unit
+ * @param unit the compilation unit information to be filled
+ * @return whether the unit is a compilation unit having a line program
+ */
+static inline bool dwarf_unitIndex_parseUnit(const struct dwarf_unitIndex_sections* self, size_t* counter,
+                                             struct dwarf_unitIndex_unit* unit) {
+    const void* buffer = self->debugInfo.content;
+    *unit = (struct dwarf_unitIndex_unit) { .version = 0 };
+    const uint64_t size = dwarf_parseInitialSize(buffer, counter, &unit->bit64);
+    if (size > self->debugInfo.size - *counter || size < 2) {
+        throw(invalid, self, "Invalid compilation unit length");
+    }
+    const size_t end = *counter + (size_t) size;
+    unit->version = *(uint16_t*) (buffer + *counter);
+    *counter += 2;
+
+    uint64_t abbrevOffset;
+    if (unit->version == 5) {
+        const uint8_t unitType = *(uint8_t*) (buffer + (*counter)++);
+        unit->addressSize = *(uint8_t*) (buffer + (*counter)++);
+        abbrevOffset = dwarf_unitIndex_readSized(self, buffer, counter, unit->bit64 ? 8 : 4);
+        if (unitType == DW_UT_skeleton) {
+            *counter += 8;
+        } else if (unitType != DW_UT_compile) {
+            *counter = end;
+            return false;
+        }
+    } else if (unit->version >= 2 && unit->version <= 4) {
+        abbrevOffset = dwarf_unitIndex_readSized(self, buffer, counter, unit->bit64 ? 8 : 4);
+        unit->addressSize = *(uint8_t*) (buffer + (*counter)++);
+    } else {
+        *counter = end;
+        return false;
+    }
+
+    uint64_t tag = 0;
+    const uint64_t code = getULEB128(buffer, counter);
+    size_t specification = code == 0 ? 0 : dwarf_unitIndex_findAbbreviation(self, abbrevOffset, code, &tag);
+    if (tag != DW_TAG_compile_unit && tag != DW_TAG_skeleton_unit) {
+        *counter = end;
+        return false;
+    }
+    for (;;) {
+        const uint64_t name = getULEB128(self->debugAbbrev.content, &specification);
+        uint64_t form = getULEB128(self->debugAbbrev.content, &specification);
+        if (name == 0 && form == 0) break;
+
+        const int64_t implicitConst = form == DW_FORM_implicit_const
+            ? getLEB128(self->debugAbbrev.content, &specification) : 0;
+        if (form == DW_FORM_indirect) {
+            form = getULEB128(buffer, counter);
+        }
+        const uint64_t value = dwarf_unitIndex_readValue(self, unit, counter, form, implicitConst);
+        struct dwarf_unitIndex_value* target;
+        switch (name) {
+            case DW_AT_stmt_list:     target = &unit->stmtList;     break;
+            case DW_AT_low_pc:        target = &unit->lowPc;        break;
+            case DW_AT_high_pc:       target = &unit->highPc;       break;
+            case DW_AT_ranges:        target = &unit->ranges;       break;
+            case DW_AT_addr_base:
+            case DW_AT_GNU_addr_base: target = &unit->addrBase;     break;
+            case DW_AT_rnglists_base: target = &unit->rnglistsBase; break;
+
+            default: continue;
+        }
+        *target = (struct dwarf_unitIndex_value) { true, form, value };
+    }
+    *counter = end;
+    return unit->stmtList.present && (unit->addressSize == 4 || unit->addressSize == 8);
+}
+
+/**
+ * Adds the address ranges listed in the @c .debug_ranges section for the
+ * given compilation unit.
+ *
+ * @param self the unit index
+ * @param sections the sections of the unit index
+ * @param unit the compilation unit information
+ * @param index the index of the compilation unit
+ * @param base the base address of the compilation unit
+ */
+static inline void dwarf_unitIndex_loadRanges(struct dwarf_unitIndex* self,
+                                              const struct dwarf_unitIndex_sections* sections,
+                                              const struct dwarf_unitIndex_unit* unit,
+                                              const size_t index, uint64_t base) {
+    const uint64_t largest = unit->addressSize == 8 ? UINT64_MAX : UINT32_MAX;
+    if (unit->ranges.value >= sections->debugRanges.size) {
+        throw(invalid, sections, "Invalid range list offset");
+    }
+    size_t counter = (size_t) unit->ranges.value;
+    while (counter + 2 * unit->addressSize <= sections->debugRanges.size) {
+        const uint64_t begin = dwarf_unitIndex_readSized(sections, sections->debugRanges.content, &counter, unit->addressSize),
+                       end   = dwarf_unitIndex_readSized(sections, sections->debugRanges.content, &counter, unit->addressSize);
+        if (begin == 0 && end == 0) {
+            break;
+        } else if (begin == largest) {
+            base = end;
+        } else {
+            dwarf_unitIndex_addRange(self, base + begin, base + end, index);
+        }
+    }
+}
+
+/**
+ * Adds the address ranges listed in the @c .debug_rnglists section for the
+ * given compilation unit.
+ *
+ * @param self the unit index
+ * @param sections the sections of the unit index
+ * @param unit the compilation unit information
+ * @param index the index of the compilation unit
+ * @param base the base address of the compilation unit
+ */
+static inline void dwarf_unitIndex_loadRangeList(struct dwarf_unitIndex* self,
+                                                 const struct dwarf_unitIndex_sections* sections,
+                                                 const struct dwarf_unitIndex_unit* unit,
+                                                 const size_t index, uint64_t base) {
+    const void* buffer = sections->debugRnglists.content;
+    const uint8_t offsetSize = unit->bit64 ? 8 : 4;
+
+    uint64_t offset = unit->ranges.value;
+    if (unit->ranges.form == DW_FORM_rnglistx) {
+        // The default base skips the header of the first range list table.
+        const uint64_t tableBase = unit->rnglistsBase.present ? unit->rnglistsBase.value : unit->bit64 ? 20 : 12;
+        if (tableBase > sections->debugRnglists.size
+            || offset >= (sections->debugRnglists.size - tableBase) / offsetSize) {
+            throw(invalid, sections, "Invalid range list index");
+        }
+        size_t counter = (size_t) (tableBase + offset * offsetSize);
+        offset = tableBase + dwarf_unitIndex_readSized(sections, buffer, &counter, offsetSize);
+    }
+    if (offset >= sections->debugRnglists.size) {
+        throw(invalid, sections, "Invalid range list offset");
+    }
+
+    const struct lcs_section rnglists = sections->debugRnglists;
+    size_t counter = (size_t) offset;
+    while (counter < rnglists.size) {
+        uint64_t begin, end;
+        switch (*(uint8_t*) (buffer + counter++)) {
+            case DW_RLE_end_of_list: return;
+
+            case DW_RLE_base_addressx:
+                base = dwarf_unitIndex_readULEB128(sections, rnglists, &counter);
+                base = dwarf_unitIndex_loadAddress(sections, unit, base);
+                continue;
+
+            case DW_RLE_base_address:
+                base = dwarf_unitIndex_readSized(sections, buffer, &counter, unit->addressSize);
+                continue;
+
+            case DW_RLE_startx_endx:
+                begin = dwarf_unitIndex_readULEB128(sections, rnglists, &counter);
+                end   = dwarf_unitIndex_readULEB128(sections, rnglists, &counter);
+                begin = dwarf_unitIndex_loadAddress(sections, unit, begin);
+                end   = dwarf_unitIndex_loadAddress(sections, unit, end);
+                break;
+
+            case DW_RLE_startx_length:
+                begin = dwarf_unitIndex_readULEB128(sections, rnglists, &counter);
+                begin = dwarf_unitIndex_loadAddress(sections, unit, begin);
+                end   = begin + dwarf_unitIndex_readULEB128(sections, rnglists, &counter);
+                break;
+
+            case DW_RLE_offset_pair:
+                begin = base + dwarf_unitIndex_readULEB128(sections, rnglists, &counter);
+                end   = base + dwarf_unitIndex_readULEB128(sections, rnglists, &counter);
+                break;
+
+            case DW_RLE_start_end:
+                begin = dwarf_unitIndex_readSized(sections, buffer, &counter, unit->addressSize);
+                end   = dwarf_unitIndex_readSized(sections, buffer, &counter, unit->addressSize);
+                break;
+
+            case DW_RLE_start_length:
+                begin = dwarf_unitIndex_readSized(sections, buffer, &counter, unit->addressSize);
+                end   = begin + dwarf_unitIndex_readULEB128(sections, rnglists, &counter);
+                break;
+
+            default: throw(unsupported, sections, "Unsupported range list entry");
+        }
+        dwarf_unitIndex_addRange(self, begin, end, index);
+    }
+}
+
+/**
+ * Adds the address ranges of the given compilation unit as described by its
+ * attributes.
+ *
+ * @param self the unit index
+ * @param sections the sections of the unit index
+ * @param unit the compilation unit information
+ * @param index the index of the compilation unit
+ */
+static inline void dwarf_unitIndex_loadUnitRanges(struct dwarf_unitIndex* self,
+                                                  const struct dwarf_unitIndex_sections* sections,
+                                                  const struct dwarf_unitIndex_unit* unit,
+                                                  const size_t index) {
+    const uint64_t lowPc = unit->lowPc.present ? dwarf_unitIndex_resolveAddress(sections, unit, unit->lowPc) : 0;
+    if (unit->ranges.present) {
+        if (unit->version >= 5) {
+            dwarf_unitIndex_loadRangeList(self, sections, unit, index, lowPc);
+        } else {
+            dwarf_unitIndex_loadRanges(self, sections, unit, index, lowPc);
+        }
+    } else if (unit->lowPc.present && unit->highPc.present) {
+        const uint64_t highPc = unit->highPc.form == DW_FORM_addr || dwarf_unitIndex_isAddressIndex(unit->highPc.form)
+            ? dwarf_unitIndex_resolveAddress(sections, unit, unit->highPc)
+            : lowPc + unit->highPc.value;
+        dwarf_unitIndex_addRange(self, lowPc, highPc, index);
+    }
+}
+
+/**
+ * Compares the given compilation unit with the given offset.
+ *
+ * @param key the offset of the searched compilation unit
+ * @param unit the compilation unit to compare with
+ * @return a value smaller, equal to or greater than @c 0 according to the order of the offsets
+ */
+static inline int dwarf_unitIndex_unitCompare(const void* key, const void* unit) {
+    const uint64_t a = *(const uint64_t*) key,
+                   b = ((const struct dwarf_unit*) unit)->offset;
+    if (a < b) return -1;
+    if (a > b) return +1;
+    return 0;
+}
+
+/**
+ * Adds the address ranges listed in the @c .debug_aranges section.
+ *
+ * @param self the unit index
+ * @param sections the sections of the unit index
+ */
+static inline void dwarf_unitIndex_loadAranges(struct dwarf_unitIndex* self,
+                                               const struct dwarf_unitIndex_sections* sections) {
+    const void* buffer = sections->debugAranges.content;
+    size_t counter = 0;
+    while (counter < sections->debugAranges.size) {
+        const size_t begin = counter;
+        bool bit64;
+        const uint64_t size = dwarf_parseInitialSize(buffer, &counter, &bit64);
+        if (size > sections->debugAranges.size - counter) {
+            throw(invalid, sections, "Invalid address range set length");
+        }
+        const size_t end = counter + (size_t) size;
+        const uint16_t version = *(uint16_t*) (buffer + counter);
+        counter += 2;
+        uint64_t offset = dwarf_unitIndex_readSized(sections, buffer, &counter, bit64 ? 8 : 4);
+        const uint8_t addressSize = *(uint8_t*) (buffer + counter++),
+                      segmentSize = *(uint8_t*) (buffer + counter++);
+
+        const struct dwarf_unit* unit = vector_search(&self->units, &offset, dwarf_unitIndex_unitCompare);
+        if (version == 2 && (addressSize == 4 || addressSize == 8) && segmentSize == 0 && unit != NULL) {
+            // The tuples are aligned to their size, relative to the beginning of the set.
+            const size_t tupleSize = 2 * addressSize;
+            counter = begin + (counter - begin + tupleSize - 1) / tupleSize * tupleSize;
+            while (counter + tupleSize <= end) {
+                const uint64_t address = dwarf_unitIndex_readSized(sections, buffer, &counter, addressSize),
+                               length  = dwarf_unitIndex_readSized(sections, buffer, &counter, addressSize);
+                if (address == 0 && length == 0) break;
+
+                dwarf_unitIndex_addRange(self, address, address + length, (size_t) (unit - self->units.content));
+            }
+        }
+        counter = end;
+    }
+}
+
+/**
+ * Compares the two given address ranges by their beginning.
+ *
+ * @param lhs the left-hand side range
+ * @param rhs the right-hand side range
+ * @return a value smaller, equal to or greater than @c 0 according to the sorting order
+ */
+static inline int dwarf_unitIndex_rangeCompare(const void* lhs, const void* rhs) {
+    const struct dwarf_unitRange* a = lhs,
+                                * b = rhs;
+    if (a->begin < b->begin) return -1;
+    if (a->begin > b->begin) return +1;
+    return 0;
+}
+
+void dwarf_unitIndex_create(struct dwarf_unitIndex* self,
+                            const struct lcs_section debugInfo,
+                            const struct lcs_section debugAbbrev,
+                            const struct lcs_section debugAranges,
+                            const struct lcs_section debugRanges,
+                            const struct lcs_section debugRnglists,
+                            const struct lcs_section debugAddr,
+                            const char* fileName) {
+    const struct dwarf_unitIndex_sections sections = {
+        debugInfo, debugAbbrev, debugAranges, debugRanges, debugRnglists, debugAddr, fileName
+    };
+    *self = (struct dwarf_unitIndex) dwarf_unitIndex_initializer;
+    vector_dwarfUnitIndexUnit_t infos = vector_initializer;
+    TRY({
+        for (size_t counter = 0; counter < debugInfo.size;) {
+            const size_t offset = counter;
+            struct dwarf_unitIndex_unit info;
+            if (dwarf_unitIndex_parseUnit(&sections, &counter, &info)) {
+                vector_push_back_throw(&self->units, ((struct dwarf_unit) { offset, info.stmtList.value, false, NULL }));
+                vector_push_back_throw(&infos, info);
+            }
+        }
+        dwarf_unitIndex_loadAranges(self, &sections);
+        for (size_t i = 0; i < self->units.count; ++i) {
+            if (!self->units.content[i].indexed) {
+                dwarf_unitIndex_loadUnitRanges(self, &sections, &infos.content[i], i);
+            }
+        }
+    }, CATCH_ALL(_, {
+        (void) _;
+        vector_destroy(&infos);
+        dwarf_unitIndex_destroy(self);
+        RETHROW;
+    }))
+    vector_destroy(&infos);
+    vector_sort(&self->ranges, dwarf_unitIndex_rangeCompare);
+}
+
+struct dwarf_unit* dwarf_unitIndex_find(const struct dwarf_unitIndex* self, const uint64_t address) {
+    size_t low = 0, high = self->ranges.count;
+    while (low < high) {
+        const size_t middle = low + (high - low) / 2;
+        if (self->ranges.content[middle].begin <= address) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    if (low == 0 || self->ranges.content[low - 1].end <= address) {
+        return NULL;
+    }
+    return &self->units.content[self->ranges.content[low - 1].unit];
+}
+
+void dwarf_unitIndex_destroy(struct dwarf_unitIndex* self) {
+    vector_iterate(&self->units, {
+        if (element->lineTable != NULL) {
+            dwarf_lineTable_destroy(element->lineTable);
+            free(element->lineTable);
+        }
+    });
+    vector_destroy(&self->units);
+    vector_destroy(&self->ranges);
+    *self = (struct dwarf_unitIndex) dwarf_unitIndex_initializer;
+}
@@ -0,0 +1,119 @@
+/*
+ * CallstackLibrary - Library creating human-readable call stacks.
+ *
+ * Copyright (C) 2026  mhahnFr
+ *
+ * This file is part of the CallstackLibrary.
+ *
+ * The CallstackLibrary is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The CallstackLibrary is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with the
+ * CallstackLibrary, see the file LICENSE.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef dwarf_unitIndex_h
+#define dwarf_unitIndex_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <DC4C/vector.h>
+
+#include "../lcs_section.h"
+#include "lineInfo/lineTable.h"
+
+/**
+ * This structure represents a compilation unit having a line program.
+ */
+struct dwarf_unit {
+    /** The offset of the compilation unit in the @c .debug_info section.  */
+    uint64_t offset;
+    /** The offset of its line program in the @c .debug_line section.     */
+    uint64_t lineProgram;
+    /** Whether address ranges covered by the compilation unit are known. */
+    bool indexed;
+    /** The decoded line table or @c NULL if not decoded yet.             */
+    struct dwarf_lineTable* lineTable;
+};
+
+/**
+ * This structure represents an address range covered by a compilation unit.
+ */
+struct dwarf_unitRange {
+    /** The unrelocated beginning of the range.      */
+    uint64_t begin;
+    /** The unrelocated end of the range, exclusive. */
+    uint64_t end;
+    /** The index of the covering compilation unit.  */
+    size_t unit;
+};
+
+typedef_vector_named(dwarfUnit, struct dwarf_unit);
+typedef_vector_named(dwarfUnitRange, struct dwarf_unitRange);
+
+/**
+ * This structure represents an index mapping addresses to the compilation
+ * units covering them.
+ */
+struct dwarf_unitIndex {
+    /** The compilation units having a line program, sorted by their offset. */
+    vector_dwarfUnit_t units;
+    /** The address ranges of the compilation units, sorted ascendingly.     */
+    vector_dwarfUnitRange_t ranges;
+};
+
+/** Initializes an empty unit index. */
+#define dwarf_unitIndex_initializer { vector_initializer, vector_initializer }
+
+/**
+ * @brief Builds the index of the compilation units found in the given sections.
+ *
+ * The address ranges are taken from the @c .debug_aranges section. The ranges
+ * of the compilation units not listed there are read from their
+ * @c DW_AT_low_pc and @c DW_AT_high_pc or @c DW_AT_ranges attributes.
+ * Compilation units whose ranges are unknown are not indexed.
+ *
+ * @param self the unit index to be constructed
+ * @param debugInfo the section corresponding to the @c .debug_info section
+ * @param debugAbbrev the section corresponding to the @c .debug_abbrev section
+ * @param debugAranges the section corresponding to the @c .debug_aranges section
+ * @param debugRanges the section corresponding to the @c .debug_ranges section
+ * @param debugRnglists the section corresponding to the @c .debug_rnglists section
+ * @param debugAddr the section corresponding to the @c .debug_addr section
+ * @param fileName the name of the file currently being parsed
+ */
+void dwarf_unitIndex_create(struct dwarf_unitIndex* self,
+                            struct lcs_section debugInfo,
+                            struct lcs_section debugAbbrev,
+                            struct lcs_section debugAranges,
+                            struct lcs_section debugRanges,
+                            struct lcs_section debugRnglists,
+                            struct lcs_section debugAddr,
+                            const char* fileName);
+
+/**
+ * Returns the compilation unit covering the given address.
+ *
+ * @param self the unit index
+ * @param address the unrelocated address
+ * @return the covering compilation unit or @c NULL if not found
+ */
+struct dwarf_unit* dwarf_unitIndex_find(const struct dwarf_unitIndex* self, uint64_t address);
+
+/**
+ * Destroys the given unit index together with the decoded line tables.
+ *
+ * @param self the unit index to be destroyed
+ */
+void dwarf_unitIndex_destroy(struct dwarf_unitIndex* self);
+
+#endif /* dwarf_unitIndex_h */
@@ -28,4 +28,6 @@
 #define DW_LNS_set_epilogue_begin 0x0b
 #define DW_LNS_set_isa            0x0c
 
+#define DW_AT_ranges 0x55
+
 #endif /* dwarf_v3_definitions_h */
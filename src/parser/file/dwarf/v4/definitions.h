@@ -26,6 +26,16 @@
 
 #define DW_LNE_set_discriminator 0x04
 
-#define DW_FORM_sec_offset 0x17
+#define DW_FORM_sec_offset   0x17
+#define DW_FORM_exprloc      0x18
+#define DW_FORM_flag_present 0x19
+#define DW_FORM_ref_sig8     0x20
+
+#define DW_FORM_GNU_addr_index 0x1f01
+#define DW_FORM_GNU_str_index  0x1f02
+#define DW_FORM_GNU_ref_alt    0x1f20
+#define DW_FORM_GNU_strp_alt   0x1f21
+
+#define DW_AT_GNU_addr_base 0x2133
 
 #endif /* dwarf_v4_definitions_h */
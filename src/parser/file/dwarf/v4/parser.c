@@ -131,12 +131,16 @@ static inline char* dwarf4_stringFrom(const struct dwarf_fileNameEntry* file,
  * @param self the generified parser object, the specific part for version 4
  * and earlier is used
  * @param file the index of the desired file
- * @return the source file reference
+ * @return the source file reference, the name is @c NULL if the index does not
+ * refer to a file
  */
 static inline struct dwarf_sourceFile dwarf4_parser_getFileName(const struct dwarf_parser* self, const uint64_t file) {
-    const struct dwarf_fileNameEntry* filePtr = file == 0 ? NULL : &self->specific.v4.fileNames.content[file - 1];
+    if (file == 0 || file > self->specific.v4.fileNames.count) {
+        return (struct dwarf_sourceFile) { NULL, NULL, NULL, 0, 0 };
+    }
+    const struct dwarf_fileNameEntry* filePtr = &self->specific.v4.fileNames.content[file - 1];
     return (struct dwarf_sourceFile) {
-        filePtr == NULL ? NULL : dwarf4_stringFrom(filePtr, &self->specific.v4.includeDirectories, self->compilationDirectory),
+        dwarf4_stringFrom(filePtr, &self->specific.v4.includeDirectories, self->compilationDirectory),
         NULL, NULL,
         filePtr->modTime,
         filePtr->size
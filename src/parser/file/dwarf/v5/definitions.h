@@ -25,16 +25,38 @@
 #include "../v4/definitions.h"
 
 #define DW_FORM_strx           0x1a
+#define DW_FORM_addrx          0x1b
+#define DW_FORM_ref_sup4       0x1c
 #define DW_FORM_strp_sup       0x1d
 #define DW_FORM_data16         0x1e
 #define DW_FORM_line_strp      0x1f
 #define DW_FORM_implicit_const 0x21
+#define DW_FORM_loclistx       0x22
+#define DW_FORM_rnglistx       0x23
+#define DW_FORM_ref_sup8       0x24
 #define DW_FORM_strx1          0x25
 #define DW_FORM_strx2          0x26
 #define DW_FORM_strx3          0x27
 #define DW_FORM_strx4          0x28
+#define DW_FORM_addrx1         0x29
+#define DW_FORM_addrx2         0x2a
+#define DW_FORM_addrx3         0x2b
+#define DW_FORM_addrx4         0x2c
+
+#define DW_TAG_skeleton_unit 0x4a
 
 #define DW_AT_str_offsets_base 0x72
+#define DW_AT_addr_base        0x73
+#define DW_AT_rnglists_base    0x74
+
+#define DW_RLE_end_of_list   0x00
+#define DW_RLE_base_addressx 0x01
+#define DW_RLE_startx_endx   0x02
+#define DW_RLE_startx_length 0x03
+#define DW_RLE_offset_pair   0x04
+#define DW_RLE_base_address  0x05
+#define DW_RLE_start_end     0x06
+#define DW_RLE_start_length  0x07
 
 #define DW_LNCT_path            0x1
 #define DW_LNCT_directory_index 0x2
@@ -262,9 +262,13 @@ static inline char* dwarf5_constructFileName(const struct fileAttribute*   file,
  *
  * @param self the generified parser object
  * @param file the file index
- * @return the source file reference
+ * @return the source file reference, the name is @c NULL if the index does not
+ * refer to a file
  */
 static inline struct dwarf_sourceFile dwarf5_getFileName(const struct dwarf_parser* self, const uint64_t file) {
+    if (file >= self->specific.v5.files.count) {
+        return (struct dwarf_sourceFile) { NULL, NULL, NULL, 0, 0 };
+    }
     const struct fileAttribute* filePtr = &self->specific.v5.files.content[file];
     return (struct dwarf_sourceFile) {
         dwarf5_constructFileName(filePtr, &self->specific.v5.directories, self->compilationDirectory),
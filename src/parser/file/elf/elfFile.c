@@ -19,21 +19,25 @@
  * CallstackLibrary, see the file LICENSE.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#define _GNU_SOURCE
+
 #include "elfFile.h"
 
+#include <dlfcn.h>
 #include <elf.h>
 #include <stdlib.h>
 #include <try_catch.h>
+#include <callstack_internals.h>
 #include <elf/elfUtils.h>
 #include <file/pathUtils.h>
-#include <misc/string_utils.h>
 
-#include "../../lcs_stdio.h"
 #include "../bounds.h"
 #include "../debugInfo.h"
+#include "../debugInfoCache.h"
 #include "../exception.h"
 #include "../loader.h"
 #include "../../callstack_parser.h"
+#include "../../../callstackFrame/callstackFrameArena.h"
 #include "../dwarf/parser.h"
 
 void elfFile_create(struct elfFile* self) {
@@ -43,25 +47,21 @@ void elfFile_create(struct elfFile* self) {
     self->debugInfo       = lcs_section_initializer;
     self->debugAbbrev     = lcs_section_initializer;
     self->debugStrOffsets = lcs_section_initializer;
+    self->debugAranges    = lcs_section_initializer;
+    self->debugRanges     = lcs_section_initializer;
+    self->debugRnglists   = lcs_section_initializer;
+    self->debugAddr       = lcs_section_initializer;
+    self->ehFrameHeader   = 0;
+    self->dynamic         = 0;
+    self->tlsSize         = 0;
+    self->units           = (struct dwarf_unitIndex) dwarf_unitIndex_initializer;
+    self->file            = (struct loader_file) loader_file_initializer;
+
+    self->lineTable       = (struct dwarf_lineTable) dwarf_lineTable_initializer;
 
-    vector_init(&self->lineInfos);
     vector_init(&self->symbols);
 }
 
-/**
- * @brief The callback for the DWARF parser.
- *
- * Stores the given DWARF line table row.
- *
- * @param info the deducted DWARF line table row
- * @param args the payload, expected to be a private elf file structure object
- */
-static inline void elfFile_lineProgramCallback(struct dwarf_lineInfo info, void* args) {
-    struct elfFile* self = args;
-
-    vector_push_back(&self->lineInfos, info);
-}
-
 /**
  * Generates an implementation for parsing the string table section.
  *
@@ -95,14 +95,11 @@ elfFile_loadSectionStrtab(64)
  * @param bits the amount of bits the implementation shall handle
  */
 #define elfFile_parseSymtab(bits)                                                                             \
-static inline void elfFile_parseSymtab##bits(struct elfFile*   self,                                          \
-                                             Elf##bits##_Shdr* symtab,                                        \
-                                             char*             strBegin,                                      \
-                                             const void*       begin,                                         \
-                                             bool              littleEndian) {                                \
-    const void* symtabBegin = begin + ELF_TO_HOST(bits, symtab->sh_offset, littleEndian);                     \
-    uint64_t count = ELF_TO_HOST(bits, symtab->sh_size, littleEndian) / sizeof(Elf##bits##_Sym);              \
-    const Elf##bits##_Sym* entry = symtabBegin;                                                               \
+static inline void elfFile_parseSymtab##bits(struct elfFile*        self,                                     \
+                                             const Elf##bits##_Sym* entry,                                    \
+                                             uint64_t               count,                                    \
+                                             const char*            strBegin,                                 \
+                                             bool                   littleEndian) {                           \
     for (uint64_t i = 0; i < count; ++i, ++entry) {                                                           \
         const unsigned char type = ELF##bits##_ST_TYPE(entry->st_info);                                       \
         if ((type == STT_FUNC || type == STT_OBJECT) && ELF_TO_HOST(bits, entry->st_value, littleEndian) != 0 \
@@ -203,6 +200,19 @@ static inline void elfFile_parseFile##bits(struct elfFile* self, const Elf##bits
             continue;                                                                                                 \
         } else if (strcmp(".debug_str_offsets", sectionName) == 0) {                                                  \
             self->debugStrOffsets = elfFile_sectionToLCSSection##bits(buffer, current, littleEndian);                 \
+            continue;                                                                                                 \
+        } else if (strcmp(".debug_aranges", sectionName) == 0) {                                                      \
+            self->debugAranges = elfFile_sectionToLCSSection##bits(buffer, current, littleEndian);                    \
+            continue;                                                                                                 \
+        } else if (strcmp(".debug_ranges", sectionName) == 0) {                                                       \
+            self->debugRanges = elfFile_sectionToLCSSection##bits(buffer, current, littleEndian);                     \
+            continue;                                                                                                 \
+        } else if (strcmp(".debug_rnglists", sectionName) == 0) {                                                     \
+            self->debugRnglists = elfFile_sectionToLCSSection##bits(buffer, current, littleEndian);                   \
+            continue;                                                                                                 \
+        } else if (strcmp(".debug_addr", sectionName) == 0) {                                                         \
+            self->debugAddr = elfFile_sectionToLCSSection##bits(buffer, current, littleEndian);                       \
+            continue;                                                                                                 \
         }                                                                                                             \
         switch (ELF_TO_HOST(32, current->sh_type, littleEndian)) {                                                    \
             case SHT_SYMTAB:                                                                                          \
@@ -235,8 +245,14 @@ static inline void elfFile_parseFile##bits(struct elfFile* self, const Elf##bits
         symtab = dysymtab;                                                                                            \
         strtab = dystrtab;                                                                                            \
     }                                                                                                                 \
-    elfFile_parseSymtab##bits(self, symtab, (void*) buffer + ELF_TO_HOST(bits, strtab->sh_offset, littleEndian),      \
-                              buffer, littleEndian);                                                                  \
+    const struct lcs_section symbols = elfFile_sectionToLCSSection##bits(buffer, symtab, littleEndian),              \
+                             strings = elfFile_sectionToLCSSection##bits(buffer, strtab, littleEndian);              \
+    loader_willNeed(symbols.content, symbols.size);                                                                   \
+    loader_willNeed(strings.content, strings.size);                                                                   \
+    elfFile_parseSymtab##bits(self, symbols.content, symbols.size / sizeof(Elf##bits##_Sym), strings.content,          \
+                              littleEndian);                                                                          \
+    loader_dontNeed(symbols.content, symbols.size);                                                                   \
+    loader_dontNeed(strings.content, strings.size);                                                                   \
 }
 
 elfFile_parseFileImpl(32)
@@ -276,6 +292,13 @@ static inline void elfFile_loadELF##bits(struct elfFile* self, const void* base,
     for (uint32_t i = 0; i < e_phnum; ++i) {                                                        \
         Elf##bits##_Phdr* seg = ((void*) header) + ELF_TO_HOST(bits, header->e_phoff, littleEndian) \
                                 + i * ELF_TO_HOST(16, header->e_phentsize, littleEndian);           \
+        if (ELF_TO_HOST(32, seg->p_type, littleEndian) == PT_GNU_EH_FRAME) {                        \
+            self->ehFrameHeader = ELF_TO_HOST(bits, seg->p_vaddr, littleEndian);                    \
+        } else if (ELF_TO_HOST(32, seg->p_type, littleEndian) == PT_DYNAMIC) {                      \
+            self->dynamic = ELF_TO_HOST(bits, seg->p_vaddr, littleEndian);                          \
+        } else if (ELF_TO_HOST(32, seg->p_type, littleEndian) == PT_TLS) {                          \
+            self->tlsSize = ELF_TO_HOST(bits, seg->p_memsz, littleEndian);                          \
+        }                                                                                           \
         const void* address = base + ELF_TO_HOST(bits, seg->p_offset, littleEndian)                 \
                              + ELF_TO_HOST(bits, seg->p_memsz, littleEndian);                       \
         if (biggest == NULL || biggest < address) {                                                 \
@@ -288,6 +311,167 @@ static inline void elfFile_loadELF##bits(struct elfFile* self, const void* base,
 elfFile_loadELF_impl(32)
 elfFile_loadELF_impl(64)
 
+/**
+ * @brief Returns the address of the given pointer of the dynamic section of
+ * the given ELF file.
+ *
+ * Depending on the dynamic loader, the pointers in the dynamic section have
+ * been relocated or not.
+ *
+ * @param self the ELF file object
+ * @param pointer the pointer stored in the dynamic section
+ * @return the loaded address
+ */
+static inline uintptr_t elfFile_dynamicPointer(const struct elfFile* self, const uintptr_t pointer) {
+    return pointer < self->_.relocationOffset ? pointer + self->_.relocationOffset : pointer;
+}
+
+/**
+ * Generates an implementation for counting the symbols covered by a GNU hash table.
+ *
+ * @param bits the amount of bits the implementation shall handle
+ */
+#define elfFile_countGnuHashSymbols(bits)                                                           \
+static inline uint32_t elfFile_countGnuHashSymbols##bits(const uint32_t* table) {                   \
+    const uint32_t bucketCount = table[0],                                                          \
+                   symbolOffset = table[1],                                                         \
+                   bloomSize    = table[2];                                                         \
+    const uint32_t* buckets = (const void*) (table + 4) + bloomSize * sizeof(Elf##bits##_Addr);     \
+    const uint32_t* chains  = buckets + bucketCount;                                                \
+                                                                                                    \
+    uint32_t last = 0;                                                                              \
+    for (uint32_t i = 0; i < bucketCount; ++i) {                                                    \
+        if (buckets[i] > last) {                                                                    \
+            last = buckets[i];                                                                      \
+        }                                                                                           \
+    }                                                                                               \
+    if (last < symbolOffset) {                                                                      \
+        return symbolOffset;                                                                        \
+    }                                                                                               \
+    while ((chains[last - symbolOffset] & 1) == 0) {                                                \
+        ++last;                                                                                     \
+    }                                                                                               \
+    return last + 1;                                                                                \
+}
+
+elfFile_countGnuHashSymbols(32)
+elfFile_countGnuHashSymbols(64)
+
+/**
+ * @brief Generates an implementation for parsing the loaded image of an ELF
+ * file.
+ *
+ * The dynamic symbol table is reached using the dynamic section, the writable
+ * segments are stored as regions.
+ *
+ * @param bits the amount of bits the implementation shall handle
+ */
+#define elfFile_parseInMemoryImpl(bits)                                                                  \
+static inline bool elfFile_parseInMemory##bits(struct elfFile* self, const Elf##bits##_Ehdr* header,     \
+                                               const bool littleEndian) {                                \
+    uintptr_t symtab = 0, strtab = 0, hash = 0, gnuHash = 0;                                             \
+    const Elf##bits##_Dyn* entry = (const void*) elfFile_dynamicPointer(self, self->dynamic);            \
+    for (; entry->d_tag != DT_NULL; ++entry) {                                                           \
+        switch (entry->d_tag) {                                                                          \
+            case DT_SYMTAB:   symtab  = elfFile_dynamicPointer(self, entry->d_un.d_ptr); break;          \
+            case DT_STRTAB:   strtab  = elfFile_dynamicPointer(self, entry->d_un.d_ptr); break;          \
+            case DT_HASH:     hash    = elfFile_dynamicPointer(self, entry->d_un.d_ptr); break;          \
+            case DT_GNU_HASH: gnuHash = elfFile_dynamicPointer(self, entry->d_un.d_ptr); break;          \
+        }                                                                                                \
+    }                                                                                                    \
+    if (symtab == 0 || strtab == 0 || (hash == 0 && gnuHash == 0)) {                                     \
+        return false;                                                                                    \
+    }                                                                                                    \
+    const uint32_t count = gnuHash != 0 ? elfFile_countGnuHashSymbols##bits((const uint32_t*) gnuHash)   \
+                                        : ((const uint32_t*) hash)[1];                                   \
+    elfFile_parseSymtab##bits(self, (const void*) symtab, count, (const char*) strtab, littleEndian);     \
+                                                                                                         \
+    const uint32_t e_phnum = elfFile_loadEPHNum##bits(header, littleEndian);                             \
+    for (uint32_t i = 0; i < e_phnum; ++i) {                                                             \
+        const Elf##bits##_Phdr* seg = ((void*) header) + header->e_phoff + i * header->e_phentsize;      \
+        if (seg->p_type == PT_LOAD && (seg->p_flags & PF_W) != 0) {                                      \
+            vector_push_back(&self->_.regions, ((pair_ptr_t) {                                           \
+                self->_.relocationOffset + seg->p_vaddr,                                                 \
+                self->_.relocationOffset + seg->p_vaddr + seg->p_memsz                                   \
+            }));                                                                                         \
+        }                                                                                                \
+    }                                                                                                    \
+    return true;                                                                                         \
+}
+
+elfFile_parseInMemoryImpl(32)
+elfFile_parseInMemoryImpl(64)
+
+/**
+ * @brief Parses the loaded image of the given ELF file.
+ *
+ * Only the dynamic symbols are available in memory, no file is read.
+ *
+ * @param self the ELF file object
+ * @return whether the loaded image could be parsed
+ */
+static inline bool elfFile_parseInMemory(struct elfFile* self) {
+    const Elf32_Ehdr* header = self->_.startAddress;
+    if (self->dynamic == 0 || header == NULL) {
+        return false;
+    }
+    const bool littleEndian = header->e_ident[EI_DATA] == ELFDATA2LSB;
+    switch (header->e_ident[EI_CLASS]) {
+        case ELFCLASS32: return elfFile_parseInMemory32(self, header, littleEndian);
+        case ELFCLASS64: return elfFile_parseInMemory64(self, (const void*) header, littleEndian);
+
+        default: return false;
+    }
+}
+
+/**
+ * @brief Loads the line information of the given ELF file.
+ *
+ * The compilation units are indexed by their address ranges, their line
+ * programs are decoded on demand. The line programs of the compilation units
+ * whose ranges are unknown are decoded right away, all of them if the index
+ * cannot be built.
+ *
+ * @param self the ELF file object
+ */
+static inline void elfFile_loadLineInfos(struct elfFile* self) {
+    if (self->debugInfo.size > 0 && self->debugAbbrev.size > 0) {
+        TRY({
+            dwarf_unitIndex_create(&self->units, self->debugInfo, self->debugAbbrev, self->debugAranges,
+                                   self->debugRanges, self->debugRnglists, self->debugAddr,
+                                   self->_.fileName.original);
+        }, CATCH_ALL(exception, {
+            BFE_EXCEPTION_HANDLER(exception);
+        }))
+    }
+    if (self->units.units.count == 0) {
+        loader_willNeed(self->debugLine.content, self->debugLine.size);
+        dwarf_parseLineProgram(self->debugLine,
+                               self->debugLineStr,
+                               self->debugStr,
+                               self->debugInfo,
+                               self->debugAbbrev,
+                               self->debugStrOffsets,
+                               self->_.fileName.original,
+                               dwarf_lineTable_add, &self->lineTable);
+        return;
+    }
+    vector_iterate(&self->units.units, {
+        if (!element->indexed) {
+            dwarf_parseUnitLineProgram(self->debugLine,
+                                       self->debugLineStr,
+                                       self->debugStr,
+                                       self->debugInfo,
+                                       self->debugAbbrev,
+                                       self->debugStrOffsets,
+                                       element->offset,
+                                       element->lineProgram,
+                                       self->_.fileName.original,
+                                       dwarf_lineTable_add, &self->lineTable);
+        }
+    });
+}
+
 /**
  * Parses the given ELF file into the given abstraction object.
  *
@@ -313,14 +497,7 @@ static inline void elfFile_parseFile(struct elfFile* self, const Elf32_Ehdr* hea
 
     if (!shallow && self->debugLine.size > 0) {
         TRY({
-            dwarf_parseLineProgram(self->debugLine,
-                                   self->debugLineStr,
-                                   self->debugStr,
-                                   self->debugInfo,
-                                   self->debugAbbrev,
-                                   self->debugStrOffsets,
-                                   self->_.fileName.original,
-                                   elfFile_lineProgramCallback, self);
+            elfFile_loadLineInfos(self);
         }, CATCH_ALL(exception, {
             BFE_EXCEPTION_HANDLER(exception);
         }))
@@ -347,48 +524,89 @@ static inline int elfFile_functionCompare(const void* lhs, const void* rhs) {
 }
 
 /**
- * @brief Returns how the two given DWARF line infos compare.
+ * @brief Decodes the line program of the given compilation unit into a newly
+ * allocated line table.
  *
- * Sorted descendingly.
+ * The line program is not decoded if the loaded file is not available.
  *
- * @param lhs the left-hand side value
- * @param rhs the right-hand side value
- * @return @c 0 if the two infos compare equal or a value smaller or greater
- * than @c 0 according to the sorting order
+ * @param self the ELF file object
+ * @param unit the compilation unit
+ * @param available whether the loaded file is available
+ * @return the line table or @c NULL if the allocation failed
  */
-static inline int elfFile_lineInfoCompare(const void* lhs, const void* rhs) {
-    const struct dwarf_lineInfo* a = lhs,
-                               * b = rhs;
-
-    if (a->address < b->address) return +1;
-    if (a->address > b->address) return -1;
-
-    return 0;
+static inline struct dwarf_lineTable* elfFile_decodeUnitLineTable(const struct elfFile* self,
+                                                                  const struct dwarf_unit* unit,
+                                                                  const bool available) {
+    struct dwarf_lineTable* toReturn = malloc(sizeof(struct dwarf_lineTable));
+    if (toReturn == NULL) return NULL;
+
+    *toReturn = (struct dwarf_lineTable) dwarf_lineTable_initializer;
+    if (available) {
+        TRY({
+            dwarf_parseUnitLineProgram(self->debugLine,
+                                       self->debugLineStr,
+                                       self->debugStr,
+                                       self->debugInfo,
+                                       self->debugAbbrev,
+                                       self->debugStrOffsets,
+                                       unit->offset,
+                                       unit->lineProgram,
+                                       self->_.fileName.original,
+                                       dwarf_lineTable_add, toReturn);
+        }, CATCH_ALL(exception, {
+            BFE_EXCEPTION_HANDLER(exception);
+        }))
+    }
+    dwarf_lineTable_compact(toReturn);
+    return toReturn;
 }
 
 /**
- * Parses the given ELF file entirely.
+ * @brief Parses the given ELF file entirely.
+ *
+ * The file is kept loaded if line programs are to be decoded on demand. If
+ * the file is not mapped into memory, the line programs of all compilation
+ * units are decoded right away instead.
  *
  * @param self the ELF file object
  * @param header the ELF file header
  */
 static inline void elfFile_parseFileComplete(struct elfFile* self, const Elf32_Ehdr* header) {
     elfFile_parseFile(self, header, false);
+    if (self->units.ranges.count == 0) return;
+
+    self->file = loader_keep();
+    if (self->file.buffer == NULL) {
+        vector_iterate(&self->units.units, {
+            if (element->indexed) {
+                element->lineTable = elfFile_decodeUnitLineTable(self, element, true);
+            }
+        });
+    }
 }
 
 void elfFile_parse(struct elfFile* self) {
+    if (callstack_functionNamesOnly && elfFile_parseInMemory(self)) {
+        vector_sort(&self->symbols, elfFile_functionCompare);
+        return;
+    }
     TRY({
         loader_loadFileAndExecute(self->_.fileName.original, (union loader_parserFunction) {
             .parseFunc = (loader_parser) elfFile_parseFileComplete
         }, false, self);
-        vector_sort(&self->symbols, elfFile_functionCompare);
-        vector_sort(&self->lineInfos, elfFile_lineInfoCompare);
     }, CATCH_ALL(_, {
         (void) _;
         vector_destroyWithPtr(&self->symbols, symbol_destroy);
         vector_init(&self->symbols);
-        RETHROW;
+        vector_clear(&self->_.regions);
+        dwarf_unitIndex_destroy(&self->units);
+        // Images without a backing file, like the vDSO, are only available in memory.
+        if (!elfFile_parseInMemory(self)) {
+            RETHROW;
+        }
     }))
+    vector_sort(&self->symbols, elfFile_functionCompare);
+    dwarf_lineTable_compact(&self->lineTable);
 }
 
 void elfFile_parseShallow(struct elfFile* self) {
@@ -396,36 +614,35 @@ void elfFile_parseShallow(struct elfFile* self) {
 }
 
 /**
- * Deducts the debugging information available for the given address in the
- * given ELF file abstraction object.
+ * Creates the debugging information from the given closest symbol and line
+ * information.
  *
- * @param self the ELF file abstraction object to be searched
- * @param address the address to be translated
- * @param function the function to be used to search within the symbol table
+ * @param self the ELF file object
+ * @param translated the unrelocated address to be translated
+ * @param closest the closest symbol or @c NULL if not found
+ * @param lineTable the line table of the closest line information
+ * @param closestInfo the closest line information or @c NULL if not found
  * @return the optionally available debug information
  */
-static inline optional_debugInfo_t elfFile_getDebugInfo(const struct elfFile* self, const void* address,
-                                                        const binaryFile_searchFunction function) {
+static inline optional_debugInfo_t elfFile_createDebugInfo(const struct elfFile* self, const uint64_t translated,
+                                                           const struct symbol* closest,
+                                                           const struct dwarf_lineTable* lineTable,
+                                                           const struct dwarf_lineRow* closestInfo) {
     optional_debugInfo_t toReturn = { .has_value = false };
-
-    const uint64_t translated = (uintptr_t) address - self->_.relocationOffset;
-    const struct symbol tmp = (struct symbol) { .startAddress = translated };
-    const struct symbol* closest = function(&tmp,
-                                            self->symbols.content,
-                                            self->symbols.count,
-                                            sizeof(struct symbol),
-                                            elfFile_functionCompare);
     if (closest == NULL
         || closest->startAddress > translated
         || closest->startAddress + closest->length < translated) {
         return toReturn;
     }
-    if (!closest->demangledName.has_value) {
-        struct symbol* mutableClosest = (struct symbol*) closest;
-        mutableClosest->demangledName = (optional_string_t) {
-            true,
-            callstack_parser_demangleCopy(closest->linkedName, false),
-        };
+    pthread_mutex_t* lock = (pthread_mutex_t*) &self->_.lock;
+    if (!__atomic_load_n(&closest->demangledName.has_value, __ATOMIC_ACQUIRE)) {
+        pthread_mutex_lock(lock);
+        if (!closest->demangledName.has_value) {
+            struct symbol* mutableClosest = (struct symbol*) closest;
+            mutableClosest->demangledName.value = callstack_parser_demangleCopy(closest->linkedName, false);
+            __atomic_store_n(&mutableClosest->demangledName.has_value, true, __ATOMIC_RELEASE);
+        }
+        pthread_mutex_unlock(lock);
     }
     toReturn = (optional_debugInfo_t) {
         .has_value = true,
@@ -435,36 +652,111 @@ static inline optional_debugInfo_t elfFile_getDebugInfo(const struct elfFile* se
         }
     };
 
-    const struct dwarf_lineInfo tmpInfo = (struct dwarf_lineInfo) { .address = translated };
-    const struct dwarf_lineInfo* closestInfo = upper_bound(&tmpInfo,
-                                                           self->lineInfos.content,
-                                                           self->lineInfos.count,
-                                                           sizeof(struct dwarf_lineInfo),
-                                                           elfFile_lineInfoCompare);
     if (closestInfo == NULL
-        || closest->startAddress >= closestInfo->address
-        || closest->startAddress + closest->length < closestInfo->address) {
+        || closest->startAddress >= dwarf_lineTable_address(lineTable, closestInfo)
+        || closest->startAddress + closest->length < dwarf_lineTable_address(lineTable, closestInfo)) {
         return toReturn;
     }
-    if (closestInfo->sourceFile.fileName != NULL && closestInfo->sourceFile.fileNameRelative == NULL && closestInfo->sourceFile.fileNameAbsolute == NULL) {
-        struct dwarf_lineInfo* mutableClosest = (struct dwarf_lineInfo*) closestInfo;
-        mutableClosest->sourceFile.fileNameRelative = path_toRelativePath(closestInfo->sourceFile.fileName);
-        mutableClosest->sourceFile.fileNameAbsolute = path_toAbsolutePath(closestInfo->sourceFile.fileName);
+    struct dwarf_sourceFile* file = dwarf_lineTable_file(lineTable, closestInfo);
+    if (file != NULL && __atomic_load_n(&file->fileNameAbsolute, __ATOMIC_ACQUIRE) == NULL) {
+        pthread_mutex_lock(lock);
+        if (file->fileNameRelative == NULL && file->fileNameAbsolute == NULL) {
+            file->fileNameRelative = path_toRelativePath(file->fileName);
+            __atomic_store_n(&file->fileNameAbsolute, path_toAbsolutePath(file->fileName), __ATOMIC_RELEASE);
+        }
+        pthread_mutex_unlock(lock);
     }
     toReturn.value.sourceFileInfo = (optional_sourceFileInfo_t) {
         .has_value = true,
         .value = {
             closestInfo->line,
             closestInfo->column,
-            closestInfo->sourceFile.fileName,
-            closestInfo->sourceFile.fileNameRelative,
-            closestInfo->sourceFile.fileNameAbsolute,
-            binaryFile_isOutdated(closestInfo->sourceFile)
+            file == NULL ? NULL : file->fileName,
+            file == NULL ? NULL : file->fileNameRelative,
+            file == NULL ? NULL : file->fileNameAbsolute,
+            file != NULL && binaryFile_isOutdated(*file)
         }
     };
     return toReturn;
 }
 
+/**
+ * @brief Returns the line table of the given compilation unit.
+ *
+ * The line program of the compilation unit is decoded on the first call. If
+ * the kept file has been modified in place since, the line table stays empty.
+ *
+ * @param self the ELF file object
+ * @param unit the compilation unit
+ * @return the line table or @c NULL if the allocation failed
+ */
+static inline const struct dwarf_lineTable* elfFile_loadUnitLineTable(const struct elfFile* self,
+                                                                      struct dwarf_unit* unit) {
+    struct dwarf_lineTable* toReturn = __atomic_load_n(&unit->lineTable, __ATOMIC_ACQUIRE);
+    if (toReturn != NULL) {
+        return toReturn;
+    }
+
+    pthread_mutex_t* lock = (pthread_mutex_t*) &self->_.lock;
+    pthread_mutex_lock(lock);
+    toReturn = unit->lineTable;
+    if (toReturn == NULL) {
+        toReturn = elfFile_decodeUnitLineTable(self, unit,
+                                               loader_isIntact(&self->file, self->_.fileName.original));
+        __atomic_store_n(&unit->lineTable, toReturn, __ATOMIC_RELEASE);
+    }
+    pthread_mutex_unlock(lock);
+    return toReturn;
+}
+
+/**
+ * @brief Returns the line table row closest below the given address.
+ *
+ * Only the line table of the compilation unit covering the address is
+ * searched; the one of the compilation units not indexed otherwise.
+ *
+ * @param self the ELF file object
+ * @param translated the unrelocated address
+ * @param lineTable set to the line table of the returned row
+ * @return the closest line table row or @c NULL if not found
+ */
+static inline const struct dwarf_lineRow* elfFile_findLineInfo(const struct elfFile* self, const uint64_t translated,
+                                                               const struct dwarf_lineTable** lineTable) {
+    *lineTable = &self->lineTable;
+    // The searched row lies strictly below the address.
+    struct dwarf_unit* unit = translated == 0 ? NULL : dwarf_unitIndex_find(&self->units, translated - 1);
+    if (unit != NULL) {
+        const struct dwarf_lineTable* unitLineTable = elfFile_loadUnitLineTable(self, unit);
+        if (unitLineTable != NULL) {
+            *lineTable = unitLineTable;
+        }
+    }
+    return dwarf_lineTable_find(*lineTable, translated);
+}
+
+/**
+ * Deducts the debugging information available for the given address in the
+ * given ELF file abstraction object.
+ *
+ * @param self the ELF file abstraction object to be searched
+ * @param address the address to be translated
+ * @param function the function to be used to search within the symbol table
+ * @return the optionally available debug information
+ */
+static inline optional_debugInfo_t elfFile_getDebugInfo(const struct elfFile* self, const void* address,
+                                                        const binaryFile_searchFunction function) {
+    const uint64_t translated = (uintptr_t) address - self->_.relocationOffset;
+    const struct symbol tmp = (struct symbol) { .startAddress = translated };
+    const struct symbol* closest = function(&tmp,
+                                            self->symbols.content,
+                                            self->symbols.count,
+                                            sizeof(struct symbol),
+                                            elfFile_functionCompare);
+    const struct dwarf_lineTable* lineTable;
+    const struct dwarf_lineRow* closestInfo = elfFile_findLineInfo(self, translated, &lineTable);
+    return elfFile_createDebugInfo(self, translated, closest, lineTable, closestInfo);
+}
+
 bool elfFile_getFunctionInfo(struct elfFile* self, const char* functionName, struct functionInfo* info) {
     if (!BINARY_FILE_SUPER(self, maybeParse)) {
         return false;
@@ -480,10 +772,152 @@ bool elfFile_getFunctionInfo(struct elfFile* self, const char* functionName, str
     return false;
 }
 
-vector_pair_ptr_t elfFile_getTLSRegions(struct elfFile* self) {
-    // TODO: Properly implement
-    (void) self;
-    return (vector_pair_ptr_t) vector_initializer;
+#if defined(__x86_64__) || defined(__aarch64__)
+/**
+ * The argument of @c __tls_get_addr identifying a thread-local variable.
+ */
+typedef struct {
+    /** The module id of the runtime image.                */
+    unsigned long module;
+    /** The offset of the variable in the thread-local block. */
+    unsigned long offset;
+} elfFile_tlsIndex;
+
+extern void* __tls_get_addr(elfFile_tlsIndex* index);
+
+/**
+ * Returns the thread pointer of the calling thread.
+ *
+ * @return the thread pointer
+ */
+static inline uintptr_t elfFile_threadPointer(void) {
+    uintptr_t pointer;
+# ifdef __x86_64__
+    __asm__("mov %%fs:0, %0" : "=r" (pointer));
+# else
+    __asm__("mrs %0, tpidr_el0" : "=r" (pointer));
+# endif
+    return pointer;
+}
+
+/**
+ * @brief Returns the size of the static thread-local storage.
+ *
+ * The size is queried from the dynamic loader, the static thread-local
+ * storage of other threads cannot be located if that fails.
+ *
+ * @return the size of the static thread-local storage or @c 0 if unknown
+ */
+static inline size_t elfFile_loadStaticTLSSize(void) {
+    static _Atomic size_t size = SIZE_MAX;
+
+    size_t toReturn = atomic_load_explicit(&size, memory_order_relaxed);
+    if (toReturn == SIZE_MAX) {
+        void (*getStaticInfo)(size_t*, size_t*) = (void (*)(size_t*, size_t*)) dlsym(RTLD_DEFAULT,
+                                                                                      "_dl_get_tls_static_info");
+        size_t alignment;
+        toReturn = 0;
+        if (getStaticInfo != NULL) {
+            getStaticInfo(&toReturn, &alignment);
+        }
+        atomic_store_explicit(&size, toReturn, memory_order_relaxed);
+    }
+    return toReturn;
+}
+
+/**
+ * @brief Returns whether the given thread-local block of the calling thread
+ * is part of its static thread-local storage.
+ *
+ * The static thread-local storage lies below the thread pointer on x86_64 and
+ * above it on AArch64.
+ *
+ * @param block the thread-local block
+ * @param threadPointer the thread pointer of the calling thread
+ * @return whether the block is found at the same offset in all threads
+ */
+static inline bool elfFile_isStaticTLS(const uintptr_t block, const uintptr_t threadPointer) {
+    const size_t size = elfFile_loadStaticTLSSize();
+# ifdef __x86_64__
+    return block < threadPointer && threadPointer - block <= size;
+# else
+    return block >= threadPointer && block - threadPointer < size;
+# endif
+}
+#endif
+
+vector_pair_ptr_t elfFile_getTLSRegions(struct elfFile* self, const pthread_t thread) {
+    vector_pair_ptr_t toReturn = vector_initializer;
+    const struct binaryFile_tls* tls = &self->_.tls;
+    if (self->tlsSize == 0 || tls->module == 0) {
+        return toReturn;
+    }
+
+    uintptr_t begin = 0;
+#if defined(__x86_64__) || defined(__aarch64__)
+    if (pthread_equal(thread, pthread_self())) {
+        begin = (uintptr_t) __tls_get_addr(&(elfFile_tlsIndex) { tls->module, 0 });
+    } else if (tls->block != NULL) {
+        // The thread pointer is at a fixed distance to the thread descriptor in all threads.
+        const uintptr_t ownBlock = (uintptr_t) tls->block - (uintptr_t) tls->thread + (uintptr_t) pthread_self();
+        if (!elfFile_isStaticTLS(ownBlock, elfFile_threadPointer())) {
+            return toReturn;
+        }
+        begin = ownBlock - (uintptr_t) pthread_self() + (uintptr_t) thread;
+    }
+#else
+    if (pthread_equal(thread, pthread_self()) && pthread_equal(thread, tls->thread)) {
+        begin = (uintptr_t) tls->block;
+    }
+#endif
+    if (begin != 0) {
+        vector_push_back(&toReturn, ((pair_ptr_t) { begin, begin + self->tlsSize }));
+    }
+    return toReturn;
+}
+
+/**
+ * Stores the given debug information into the given callstack frame.
+ *
+ * @param self the ELF file object
+ * @param address the symbolized address
+ * @param result the debug information of the given address
+ * @param frame the @c callstack_frame structure to be filled
+ * @param forceDiff whether to add the difference value to the name if no line
+ * information is available and that difference is zero
+ * @return whether the symbolization was successful
+ */
+static inline bool elfFile_fillFrame(struct elfFile* self, const void* address,
+                                     const optional_debugInfo_t result, struct callstack_frame* frame,
+                                     const bool forceDiff) {
+    if (!result.has_value || result.value.symbol.linkedName == NULL) {
+        return false;
+    }
+    const char* name = callstack_rawNames || result.value.symbol.demangledName.value == NULL
+        ? result.value.symbol.linkedName : result.value.symbol.demangledName.value;
+    const bool borrow = callstackFrameArena_borrow(&self->_, frame->reserved1);
+    frame->reserved1 = borrow;
+    if (result.value.sourceFileInfo.has_value) {
+        frame->sourceFile = callstackFrameArena_maybeCopy(result.value.sourceFileInfo.value.sourceFileAbsolute, !borrow);
+        frame->sourceFileRelative = callstackFrameArena_maybeCopy(result.value.sourceFileInfo.value.sourceFileRelative, !borrow);
+        frame->sourceFileOutdated = result.value.sourceFileInfo.value.outdated;
+        frame->sourceLine = result.value.sourceFileInfo.value.line;
+        frame->sourceLineColumn = result.value.sourceFileInfo.value.column;
+        frame->function = callstackFrameArena_maybeCopy(name, !borrow);
+        frame->reserved2 = borrow;
+    } else {
+        char* toReturn = NULL;
+        const ptrdiff_t diff = (ptrdiff_t) (address - self->_.relocationOffset - result.value.symbol.startAddress);
+        if (diff > 0 || forceDiff) {
+            toReturn = callstackFrameArena_format("%s + %td", name, diff);
+            frame->reserved2 = false;
+        } else {
+            toReturn = callstackFrameArena_maybeCopy(name, !borrow);
+            frame->reserved2 = borrow;
+        }
+        frame->function = toReturn;
+    }
+    return true;
 }
 
 /**
@@ -503,36 +937,7 @@ static inline bool elfFile_addr2StringImpl(struct elfFile* self, const void* add
         return false;
     }
 
-    const optional_debugInfo_t result = elfFile_getDebugInfo(self, address, function);
-    if (result.has_value) {
-        if (result.value.symbol.linkedName == NULL) {
-            return false;
-        }
-        const char* name = callstack_rawNames || result.value.symbol.demangledName.value == NULL
-            ? result.value.symbol.linkedName : result.value.symbol.demangledName.value;
-        if (result.value.sourceFileInfo.has_value) {
-            frame->sourceFile = utils_maybeCopySave(result.value.sourceFileInfo.value.sourceFileAbsolute, !frame->reserved1);
-            frame->sourceFileRelative = utils_maybeCopySave(result.value.sourceFileInfo.value.sourceFileRelative, !frame->reserved1);
-            frame->sourceFileOutdated = result.value.sourceFileInfo.value.outdated;
-            frame->sourceLine = result.value.sourceFileInfo.value.line;
-            frame->sourceLineColumn = result.value.sourceFileInfo.value.column;
-            frame->function = utils_maybeCopySave(name, !frame->reserved1);
-            frame->reserved2 = frame->reserved1;
-        } else {
-            char* toReturn = NULL;
-            const ptrdiff_t diff = (ptrdiff_t) (address - self->_.relocationOffset - result.value.symbol.startAddress);
-            if (diff > 0 || forceDiff) {
-                asprintf(&toReturn, "%s + %td", name, diff);
-                frame->reserved2 = false;
-            } else {
-                toReturn = utils_maybeCopySave(name, !frame->reserved1);
-                frame->reserved2 = frame->reserved1;
-            }
-            frame->function = toReturn;
-        }
-        return true;
-    }
-    return false;
+    return elfFile_fillFrame(self, address, elfFile_getDebugInfo(self, address, function), frame, forceDiff);
 }
 
 bool elfFile_getSymbolInfo(struct elfFile* self, const void* symbolAddress, struct callstack_frame* frame) {
@@ -540,12 +945,47 @@ bool elfFile_getSymbolInfo(struct elfFile* self, const void* symbolAddress, stru
 }
 
 bool elfFile_addr2String(struct elfFile* self, const void* address, struct callstack_frame* frame) {
-    return elfFile_addr2StringImpl(self, address, frame, upper_bound, true);
+    if (!BINARY_FILE_SUPER(self, maybeParse)) {
+        return false;
+    }
+
+    optional_debugInfo_t info;
+    if (!debugInfoCache_load(address, &info)) {
+        info = elfFile_getDebugInfo(self, address, upper_bound);
+        debugInfoCache_store(address, &info);
+    }
+    return elfFile_fillFrame(self, address, info, frame, true);
+}
+
+void elfFile_addr2StringSorted(struct elfFile* self, void* const addresses[], struct callstack_frame frames[],
+                               const size_t count) {
+    if (!BINARY_FILE_SUPER(self, maybeParse)) {
+        return;
+    }
+
+    // The symbols are sorted descendingly, they are therefore swept from their end.
+    size_t symbol = self->symbols.count;
+    for (size_t i = 0; i < count; ++i) {
+        const uint64_t translated = (uintptr_t) addresses[i] - self->_.relocationOffset;
+        while (symbol > 0 && self->symbols.content[symbol - 1].startAddress < translated) --symbol;
+
+        optional_debugInfo_t info;
+        if (!debugInfoCache_load(addresses[i], &info)) {
+            const struct symbol* closest = symbol < self->symbols.count ? &self->symbols.content[symbol] : NULL;
+            const struct dwarf_lineTable* lineTable;
+            const struct dwarf_lineRow* closestInfo = elfFile_findLineInfo(self, translated, &lineTable);
+            info = elfFile_createDebugInfo(self, translated, closest, lineTable, closestInfo);
+            debugInfoCache_store(addresses[i], &info);
+        }
+        elfFile_fillFrame(self, addresses[i], info, &frames[i], true);
+    }
 }
 
 void elfFile_destroy(struct elfFile* self) {
     vector_destroyWithPtr(&self->symbols, symbol_destroy);
-    vector_destroyWith(&self->lineInfos, dwarf_lineInfo_destroyValue);
+    dwarf_lineTable_destroy(&self->lineTable);
+    dwarf_unitIndex_destroy(&self->units);
+    loader_unloadFile(&self->file);
 }
 
 void elfFile_delete(struct elfFile* self) {
@@ -24,8 +24,10 @@
 
 #include "../binaryFile.h"
 #include "../lcs_section.h"
+#include "../loader.h"
 #include "../symbol.h"
-#include "../dwarf/lineInfo/lineInfo.h"
+#include "../dwarf/unitIndex.h"
+#include "../dwarf/lineInfo/lineTable.h"
 
 /**
  * This structure represents an ELF binary file.
@@ -45,12 +47,31 @@ struct elfFile {
     /** The section corresponding to the @c .debug_abbrev section.   */
                        debugAbbrev,
     /** The section corresponding to the @c .debug_str_offsets.      */
-                       debugStrOffsets;
+                       debugStrOffsets,
+    /** The section corresponding to the @c .debug_aranges section.  */
+                       debugAranges,
+    /** The section corresponding to the @c .debug_ranges section.   */
+                       debugRanges,
+    /** The section corresponding to the @c .debug_rnglists section. */
+                       debugRnglists,
+    /** The section corresponding to the @c .debug_addr section.     */
+                       debugAddr;
+
+    /** The unrelocated address of the @c .eh_frame_hdr section or 0. */
+    uint64_t ehFrameHeader;
+    /** The unrelocated address of the dynamic section or 0.         */
+    uint64_t dynamic;
+    /** The size of the thread-local storage block or 0.             */
+    uint64_t tlsSize;
     
     /** The functions found in the represented ELF file.             */
     vector_symbol_t symbols;
-    /* The DWARF line information found in the represented ELF file. */
-    vector_dwarfLineInfo_t lineInfos;
+    /** The line table of the compilation units not indexed.          */
+    struct dwarf_lineTable lineTable;
+    /** The compilation units whose line programs are decoded on demand. */
+    struct dwarf_unitIndex units;
+    /** The file kept loaded for decoding the line programs on demand.   */
+    struct loader_file file;
 };
 
 /**
@@ -85,6 +106,21 @@ void elfFile_parseShallow(struct elfFile* self);
  */
 bool elfFile_addr2String(struct elfFile* self, const void* address, struct callstack_frame* frame);
 
+/**
+ * @brief Loads the debug information available for the given addresses into
+ * the given callstack frame objects.
+ *
+ * The symbol table is swept once for all addresses. The frames of addresses
+ * that could not be translated are left untouched.
+ *
+ * @param self the binary file object
+ * @param addresses the addresses to get debug information for, sorted ascendingly
+ * @param frames the callstack frame objects to store the information in
+ * @param count the count of addresses
+ */
+void elfFile_addr2StringSorted(struct elfFile* self, void* const addresses[], struct callstack_frame frames[],
+                               size_t count);
+
 /**
  * Loads the function information for the function of the given name.
  *
@@ -106,12 +142,30 @@ bool elfFile_getFunctionInfo(struct elfFile* self, const char* functionName, str
 bool elfFile_getSymbolInfo(struct elfFile* self, const void* symbolAddress, struct callstack_frame* frame);
 
 /**
- * Returns the thread-local storage regions in the given ELF file.
+ * @brief Returns the in-memory @c .eh_frame_hdr section of the given ELF file.
+ *
+ * The section is located by the shallow parsing of the in-memory image.
+ *
+ * @param self the ELF file abstraction structure
+ * @return the @c .eh_frame_hdr section or @c NULL if not available
+ */
+static inline const void* elfFile_getEHFrameHeader(const struct elfFile* self) {
+    return self->ehFrameHeader == 0 ? NULL : (const void*) (uintptr_t) (self->_.relocationOffset + self->ehFrameHeader);
+}
+
+/**
+ * @brief Returns the thread-local storage block of the given ELF file for the
+ * given thread.
+ *
+ * The block of the calling thread is allocated if that has not happened yet.
+ * Of other threads, only the blocks in the static thread-local storage are
+ * found, located relative to their thread pointer.
  *
  * @param self the ELF file abstraction structure
+ * @param thread the thread whose thread-local storage block to return
  * @return the thread-local storage regions
  */
-vector_pair_ptr_t elfFile_getTLSRegions(struct elfFile* self);
+vector_pair_ptr_t elfFile_getTLSRegions(struct elfFile* self, pthread_t thread);
 
 /**
  * Deinitializes the given binary file structure, if it is an ELF file
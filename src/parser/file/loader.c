@@ -21,46 +21,168 @@
 
 #include "loader.h"
 
-#include <stdio.h>
+#include <fcntl.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 
 #include "exception.h"
 
+/** The file loaded while being parsed by the calling thread. */
+static _Thread_local struct {
+    /** The loaded file.                                   */
+    struct loader_file file;
+    /** Whether the file is kept loaded after the parsing. */
+    bool kept;
+} loader_current;
+
+/**
+ * @brief Reads the given file into a newly allocated buffer.
+ *
+ * Used if the file cannot be mapped into memory.
+ *
+ * @param fd the file descriptor
+ * @param size the size of the file
+ * @return the allocated buffer or @c NULL if the file could not be read
+ */
+static inline void* loader_readFile(const int fd, const size_t size) {
+    char* buffer = malloc(size);
+    if (buffer == NULL) return NULL;
+
+    for (size_t count = 0; count < size;) {
+        const ssize_t result = read(fd, buffer + count, size - count);
+        if (result <= 0) {
+            free(buffer);
+            return NULL;
+        }
+        count += (size_t) result;
+    }
+    return buffer;
+}
+
+void loader_unloadFile(struct loader_file* file) {
+    if (file->buffer == NULL) return;
+
+    if (file->mapped) {
+        munmap(file->buffer, file->size);
+    } else {
+        free(file->buffer);
+    }
+    *file = (struct loader_file) loader_file_initializer;
+}
+
+struct loader_file loader_keep(void) {
+    if (!loader_current.file.mapped) {
+        return (struct loader_file) loader_file_initializer;
+    }
+    loader_current.kept = true;
+    return loader_current.file;
+}
+
+bool loader_isIntact(const struct loader_file* file, const char* fileName) {
+    if (file->buffer == NULL) return false;
+
+    struct stat fileStats;
+    if (stat(fileName, &fileStats) != 0
+        || fileStats.st_dev != file->device || fileStats.st_ino != file->inode) {
+        return true;
+    }
+    return (size_t) fileStats.st_size == file->size && fileStats.st_mtime == file->lastModified;
+}
+
 void loader_loadFileAndExecuteTime(const char* fileName, const time_t* lastModified,
                                    const union loader_parserFunction func, const bool extended, void* args) {
     if (fileName == NULL) {
         BFE_THROW_RAW(empty, fileName, "No file name given");
     }
+    const int fd = open(fileName, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        BFE_THROW_RAW(failed, fileName, "Could not open file");
+    }
     struct stat fileStats;
-    if (stat(fileName, &fileStats) != 0) {
+    if (fstat(fd, &fileStats) != 0) {
+        close(fd);
         BFE_THROW_RAW(failed, fileName, "Could not stat file name");
     }
     if (lastModified != NULL && fileStats.st_mtime != *lastModified) {
+        close(fd);
         BFE_THROW_RAW(invalid, fileName, "File last modified timestamp does not match given last modified time");
     }
-    void* buffer = BFE_ALLOC_MSG(fileStats.st_size, "Failed to allocate file buffer");
-    FILE* file = fopen(fileName, "r");
-    if (file == NULL) {
-        free(buffer);
-        BFE_THROW_RAW(failed, fileName, "Could not open file");
+    if (fileStats.st_size <= 0) {
+        close(fd);
+        BFE_THROW_RAW(empty, fileName, "File is empty");
     }
-    const size_t count = fread(buffer, 1, fileStats.st_size, file);
-    fclose(file);
-    if ((off_t) count != fileStats.st_size) {
-        free(buffer);
+    const size_t size = (size_t) fileStats.st_size;
+
+    // Only the pages of the parsed sections are faulted in, the parsers hint
+    // which ones they are going to read.
+    bool mapped = true;
+    void* buffer = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (buffer == MAP_FAILED) {
+        mapped = false;
+        buffer = loader_readFile(fd, size);
+    } else {
+        madvise(buffer, size, MADV_RANDOM);
+    }
+    close(fd);
+    if (buffer == NULL) {
         BFE_THROW_RAW(failed, fileName, "Could not read file");
     }
+    const __typeof__(loader_current) previous = loader_current;
+    loader_current.file = (struct loader_file) {
+        buffer, size, mapped, fileStats.st_dev, fileStats.st_ino, fileStats.st_mtime
+    };
+    loader_current.kept = false;
     TRY({
         if (extended) {
-            func.parseFuncExtended(buffer, fileName, count, args);
+            func.parseFuncExtended(buffer, fileName, size, args);
         } else {
             func.parseFunc(args, buffer);
         }
     }, CATCH_ALL(_, {
         (void) _;
-        free(buffer);
+        struct loader_file file = loader_current.file;
+        loader_current = previous;
+        loader_unloadFile(&file);
         RETHROW;
     }))
-    free(buffer);
+    struct loader_file file = loader_current.file;
+    const bool kept = loader_current.kept;
+    loader_current = previous;
+    if (!kept) {
+        loader_unloadFile(&file);
+    }
+}
+
+/**
+ * @brief Applies the given advice to the pages spanning the given range of a
+ * loaded file.
+ *
+ * Nothing is done if the range is not part of the file mapped by the calling
+ * thread, since the advice would discard the content of anonymous memory.
+ *
+ * @param begin the beginning of the range
+ * @param size the size of the range in bytes
+ * @param advice the advice to be given
+ */
+static inline void loader_advise(const void* begin, const size_t size, const int advice) {
+    const struct loader_file* file = &loader_current.file;
+    if (size == 0 || !file->mapped || (const char*) begin < (const char*) file->buffer
+        || size > (size_t) ((const char*) file->buffer + file->size - (const char*) begin)) {
+        return;
+    }
+
+    const uintptr_t pageSize = (uintptr_t) sysconf(_SC_PAGESIZE);
+    const uintptr_t start    = (uintptr_t) begin & ~(pageSize - 1);
+    madvise((void*) start, (uintptr_t) begin + size - start, advice);
+}
+
+void loader_willNeed(const void* begin, const size_t size) {
+    loader_advise(begin, size, MADV_WILLNEED);
+}
+
+void loader_dontNeed(const void* begin, const size_t size) {
+    loader_advise(begin, size, MADV_DONTNEED);
 }
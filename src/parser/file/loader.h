@@ -23,7 +23,30 @@
 #define loader_h
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <time.h>
+#include <sys/types.h>
+
+/**
+ * This structure represents a file loaded into memory.
+ */
+struct loader_file {
+    /** The loaded content of the file.         */
+    void* buffer;
+    /** The size of the file in bytes.          */
+    size_t size;
+    /** Whether the file is mapped into memory. */
+    bool mapped;
+    /** The device the file is stored on.       */
+    dev_t device;
+    /** The inode number of the file.           */
+    ino_t inode;
+    /** The last modified timestamp of the file. */
+    time_t lastModified;
+};
+
+/** Initializes a loaded file structure representing no file. */
+#define loader_file_initializer { NULL, 0, false, 0, 0, 0 }
 
 /**
  * @brief The simple parser callback function prototype.
@@ -61,6 +84,9 @@ union loader_parserFunction {
  * The parser function is only called when the file was loaded successfully and
  * the last modified timestamp of the file either equals the given one or
  * @c NULL is given as timestamp.
+ * <br><br>
+ * The file is mapped read-only into memory and is only valid during the call
+ * of the parser function, unless it is kept loaded by it.
  *
  * @param fileName the name of the file to be loaded
  * @param lastModified
@@ -92,4 +118,67 @@ static inline void loader_loadFileAndExecute(const char* fileName, const union l
     loader_loadFileAndExecuteTime(fileName, NULL, func, extended, args);
 }
 
+/**
+ * @brief Hints that the given range of the file being loaded is going to be
+ * read.
+ *
+ * Used by the parser functions for the sections they parse; the pages of the
+ * range are read ahead.
+ *
+ * @param begin the beginning of the range
+ * @param size the size of the range in bytes
+ */
+void loader_willNeed(const void* begin, size_t size);
+
+/**
+ * @brief Hints that the given range of the file being loaded is not going to
+ * be read anymore.
+ *
+ * The pages of the range are dropped, bounding the resident memory needed
+ * for parsing big files.
+ *
+ * @param begin the beginning of the range
+ * @param size the size of the range in bytes
+ */
+void loader_dontNeed(const void* begin, size_t size);
+
+/**
+ * @brief Keeps the file being parsed by the calling thread loaded after the
+ * parser function has returned, if it is mapped into memory.
+ *
+ * A file read into memory is not kept, since it would occupy its whole size
+ * on the heap. Only to be called by a parser function; the file is unloaded
+ * nonetheless if the parser function throws.<br>
+ * The mapping of a kept file reflects the file on disk: If it is modified in
+ * place, the content changes and reading beyond a truncation raises
+ * @c SIGBUS . Use @code loader_isIntact(const struct loader_file*, const char*)@endcode
+ * before reading from a kept file.
+ *
+ * @return the kept file, to be unloaded using
+ * @code loader_unloadFile(struct loader_file*)@endcode, or a file
+ * representing no file if it is not mapped
+ */
+struct loader_file loader_keep(void);
+
+/**
+ * @brief Returns whether the given kept file has not been modified in place
+ * since it was loaded.
+ *
+ * A file replaced or removed under the given name does not affect the kept
+ * mapping. Modifications within the granularity of the last modified
+ * timestamp that keep the size are not detected.
+ *
+ * @param file the kept file
+ * @param fileName the name the file was loaded by
+ * @return whether the kept file can be read
+ */
+bool loader_isIntact(const struct loader_file* file, const char* fileName);
+
+/**
+ * Unloads the given file that has been kept loaded.
+ *
+ * @param file the file to be unloaded, may represent no file
+ */
+void loader_unloadFile(struct loader_file* file);
+
 #endif /* loader_h */
@@ -38,8 +38,15 @@
 #include "../exception.h"
 #include "../loader.h"
 #include "../../callstack_parser.h"
+#include "../../../callstackFrame/callstackFrameArena.h"
 #include "../dwarf/leb128.h"
 
+/**
+ * The lock guarding the lazily loaded debug information, which is shared
+ * between the Mach-O files by the cache.
+ */
+static pthread_mutex_t machoFile_lock = PTHREAD_MUTEX_INITIALIZER;
+
 void machoFile_create(struct machoFile* self) {
     self->addressOffset    = 0;
     self->linkedit_fileoff = 0;
@@ -456,8 +463,8 @@ bool machoFile_getFunctionInfo(struct machoFile* self, const char* functionName,
     return false;
 }
 
-vector_pair_ptr_t machoFile_getTLSRegions(struct machoFile* self) {
-    if (!BINARY_FILE_SUPER(self, maybeParse)) {
+vector_pair_ptr_t machoFile_getTLSRegions(struct machoFile* self, const pthread_t thread) {
+    if (!pthread_equal(thread, pthread_self()) || !BINARY_FILE_SUPER(self, maybeParse)) {
         return (vector_pair_ptr_t) vector_initializer;
     }
 
@@ -486,7 +493,9 @@ static inline bool machoFile_addr2StringImpl(struct machoFile* self, const void*
         return false;
     }
 
+    pthread_mutex_lock(&machoFile_lock);
     const optional_debugInfo_t result = machoFile_getDebugInfo(self, address, searchFunction);
+    pthread_mutex_unlock(&machoFile_lock);
     if (result.has_value) {
         if (result.value.symbol.linkedName == NULL) {
             return false;
@@ -509,25 +518,31 @@ static inline bool machoFile_addr2StringImpl(struct machoFile* self, const void*
             }
         }
 
+        const bool borrow = callstackFrameArena_borrow(&self->_, frame->reserved1);
+        frame->reserved1 = borrow;
         if (result.value.sourceFileInfo.has_value) {
-            frame->sourceFile = utils_maybeCopySave(result.value.sourceFileInfo.value.sourceFileAbsolute, !frame->reserved1);
-            frame->sourceFileRelative = utils_maybeCopySave(result.value.sourceFileInfo.value.sourceFileRelative, !frame->reserved1);
+            // The source file names belong to the cached object files, which are not kept alive by an arena.
+            if (callstackFrameArena_isEntered()) {
+                frame->reserved1 = false;
+            }
+            frame->sourceFile = callstackFrameArena_maybeCopy(result.value.sourceFileInfo.value.sourceFileAbsolute, !frame->reserved1);
+            frame->sourceFileRelative = callstackFrameArena_maybeCopy(result.value.sourceFileInfo.value.sourceFileRelative, !frame->reserved1);
             frame->sourceFileOutdated = result.value.sourceFileInfo.value.outdated;
             frame->sourceLine = result.value.sourceFileInfo.value.line;
             frame->sourceLineColumn = result.value.sourceFileInfo.value.column;
-            frame->function = utils_maybeCopySave(name, !frame->reserved1);
-            frame->reserved2 = frame->reserved1;
+            frame->function = callstackFrameArena_maybeCopy(name, !borrow);
+            frame->reserved2 = borrow;
         } else {
             char* toReturn = NULL;
             const ptrdiff_t diff = (ptrdiff_t) (address - self->_.startAddress
                                       + (self->_.inMemory ? self->text_vmaddr : self->addressOffset)
                                       - result.value.symbol.startAddress);
             if (diff > 0 || forceDiff) {
-                asprintf(&toReturn, "%s + %td", name, diff);
+                toReturn = callstackFrameArena_format("%s + %td", name, diff);
                 frame->reserved2 = false;
             } else {
-                toReturn = utils_maybeCopySave(name, !frame->reserved1);
-                frame->reserved2 = frame->reserved1;
+                toReturn = callstackFrameArena_maybeCopy(name, !borrow);
+                frame->reserved2 = borrow;
             }
             frame->function = toReturn;
         }
@@ -544,6 +559,13 @@ bool machoFile_addr2String(struct machoFile* self, const void* address, struct c
     return machoFile_addr2StringImpl(self, address, frame, upper_bound, true);
 }
 
+void machoFile_addr2StringSorted(struct machoFile* self, void* const addresses[], struct callstack_frame frames[],
+                                 const size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        machoFile_addr2String(self, addresses[i], &frames[i]);
+    }
+}
+
 void machoFile_destroy(struct machoFile* self) {
     vector_iterate(&self->symbols, symbol_destroy(&element->first););
     vector_destroy(&self->symbols);
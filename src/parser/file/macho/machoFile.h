@@ -90,6 +90,20 @@ void machoFile_parseShallow(struct machoFile* self);
  */
 bool machoFile_addr2String(struct machoFile* self, const void* address, struct callstack_frame* frame);
 
+/**
+ * @brief Stores all debug information that is possible to deduct about the
+ * given addresses into the given callstack frame objects.
+ *
+ * The frames of addresses that could not be translated are left untouched.
+ *
+ * @param self the binary file the given addresses are in
+ * @param addresses the addresses to be translated, sorted ascendingly
+ * @param frames the callstack frame objects to store the debug information in
+ * @param count the count of addresses
+ */
+void machoFile_addr2StringSorted(struct machoFile* self, void* const addresses[], struct callstack_frame frames[],
+                                 size_t count);
+
 /**
  * Tries to fill the given function info structure with the information for the
  * function of the given name.
@@ -112,12 +126,16 @@ bool machoFile_getFunctionInfo(struct machoFile* self, const char* functionName,
 bool machoFile_getSymbolInfo(struct machoFile* self, const void* symbolAddress, struct callstack_frame* frame);
 
 /**
- * Returns the contained thread-local storage regions.
+ * @brief Returns the contained thread-local storage regions of the given thread.
+ *
+ * The thread-local variables of other threads than the calling one cannot be
+ * located.
  *
  * @param self the Mach-O file abstraction structure
+ * @param thread the thread whose thread-local storage regions to return
  * @return the contained thread-local storage regions
  */
-vector_pair_ptr_t machoFile_getTLSRegions(struct machoFile* self);
+vector_pair_ptr_t machoFile_getTLSRegions(struct machoFile* self, pthread_t thread);
 
 /**
  * Loads and parses the Mach-O file represented by the given Mach-O file
@@ -28,7 +28,6 @@
 
 #include "macho_parser.h"
 #include "../binaryFile.h"
-#include "../bounds.h"
 #include "../exception.h"
 #include "../loader.h"
 #include "../dwarf/parser.h"
@@ -50,38 +49,6 @@ struct objectFile* objectFile_new(void) {
     return self;
 }
 
-/**
- * The callback function for adding a deducted DWARF line information.
- *
- * @param info the DWARF line info entry
- * @param args the variadic arguments - should include as the first argument the object file object
- */
-static inline void objectFile_dwarfLineCallback(struct dwarf_lineInfo info, void* args) {
-    struct objectFile* self = args;
-    
-    vector_push_back(&self->lineInfos, info);
-}
-
-/**
- * @brief Returns how the two given DWARF line infos compare.
- *
- * Sorted descendingly.
- *
- * @param lhs the left-hand side value
- * @param rhs the right-hand side value
- * @return @c 0 if the two infos compare equal, a value smaller or bigger than
- * @c 0 according to the sort order
- */
-static inline int objectFile_dwarfLineInfoSortCompare(const void* lhs, const void* rhs) {
-    const struct dwarf_lineInfo* a = lhs;
-    const struct dwarf_lineInfo* b = rhs;
-
-    if (a->address < b->address) return +1;
-    if (a->address > b->address) return -1;
-
-    return 0;
-}
-
 /**
  * @brief Returns how the two given symbols compare.
  *
@@ -186,20 +153,18 @@ optional_debugInfo_t objectFile_getDebugInfo(struct objectFile* self, const uint
         symbolBegin = ownSymbol.value.startAddress;
     }
 
-    const struct dwarf_lineInfo tmp = (struct dwarf_lineInfo) { .address = lineAddress };
-    const struct dwarf_lineInfo* closest = upper_bound(&tmp,
-                                                       self->lineInfos.content,
-                                                       self->lineInfos.count,
-                                                       sizeof(struct dwarf_lineInfo),
-                                                       objectFile_dwarfLineInfoSortCompare);
-    if (closest == NULL || closest->address < symbolBegin
-        || (symbol.length != 0 && closest->address >= symbolBegin + symbol.length)) {
+    const struct dwarf_lineRow* closest = dwarf_lineTable_find(&self->lineTable, lineAddress);
+    if (closest == NULL) {
+        return ERROR_RETURN;
+    }
+    const uint64_t closestAddress = dwarf_lineTable_address(&self->lineTable, closest);
+    if (closestAddress < symbolBegin || (symbol.length != 0 && closestAddress >= symbolBegin + symbol.length)) {
         return ERROR_RETURN;
     }
-    if (closest->sourceFile.fileName != NULL && closest->sourceFile.fileNameRelative == NULL && closest->sourceFile.fileNameAbsolute == NULL) {
-        struct dwarf_lineInfo* mutableClosest = (struct dwarf_lineInfo*) closest;
-        mutableClosest->sourceFile.fileNameRelative = path_toRelativePath(closest->sourceFile.fileName);
-        mutableClosest->sourceFile.fileNameAbsolute = path_toAbsolutePath(closest->sourceFile.fileName);
+    struct dwarf_sourceFile* file = dwarf_lineTable_file(&self->lineTable, closest);
+    if (file != NULL && file->fileNameRelative == NULL && file->fileNameAbsolute == NULL) {
+        file->fileNameRelative = path_toRelativePath(file->fileName);
+        file->fileNameAbsolute = path_toAbsolutePath(file->fileName);
     }
     return (optional_debugInfo_t) {
         true, (struct debugInfo) {
@@ -207,10 +172,10 @@ optional_debugInfo_t objectFile_getDebugInfo(struct objectFile* self, const uint
                 true, (struct sourceFileInfo) {
                     closest->line,
                     closest->column,
-                    closest->sourceFile.fileName == NULL ? objectFile_getSourceFileName(self) : closest->sourceFile.fileName,
-                    closest->sourceFile.fileName == NULL ? self->mainSourceFileCacheRelative : closest->sourceFile.fileNameRelative,
-                    closest->sourceFile.fileName == NULL ? self->mainSourceFileCacheAbsolute : closest->sourceFile.fileNameAbsolute,
-                    binaryFile_isOutdated(closest->sourceFile)
+                    file == NULL ? objectFile_getSourceFileName(self) : file->fileName,
+                    file == NULL ? self->mainSourceFileCacheRelative : file->fileNameRelative,
+                    file == NULL ? self->mainSourceFileCacheAbsolute : file->fileNameAbsolute,
+                    file != NULL && binaryFile_isOutdated(*file)
                 }
             }
         }
@@ -360,7 +325,7 @@ static inline void objectFile_parseMachO(struct objectFile* self, const void* bu
                                    self->debugAbbrev,
                                    self->debugStrOffsets,
                                    self->name,
-                                   objectFile_dwarfLineCallback, self);
+                                   dwarf_lineTable_add, &self->lineTable);
         }, CATCH_ALL(exception, {
             BFE_EXCEPTION_HANDLER(exception);
         }))
@@ -370,7 +335,7 @@ static inline void objectFile_parseMachO(struct objectFile* self, const void* bu
 void objectFile_parseBuffer(struct objectFile* self, const void* buffer) {
     TRY({
         objectFile_parseMachO(self, buffer);
-        vector_sort(&self->lineInfos, objectFile_dwarfLineInfoSortCompare);
+        dwarf_lineTable_compact(&self->lineTable);
         vector_sort(&self->ownSymbols, objectFile_symbolCompare);
     }, CATCH_ALL(_, {
         (void) _;
@@ -382,7 +347,7 @@ void objectFile_parseBuffer(struct objectFile* self, const void* buffer) {
 
 void objectFile_destroy(struct objectFile* self) {
     vector_destroyWithPtr(&self->ownSymbols, symbol_destroy);
-    vector_destroyWithPtr(&self->lineInfos, dwarf_lineInfo_destroy);
+    dwarf_lineTable_destroy(&self->lineTable);
     free((void*) self->mainSourceFileCache);
     free((void*) self->mainSourceFileCacheRelative);
     free((void*) self->mainSourceFileCacheAbsolute);
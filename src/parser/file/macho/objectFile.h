@@ -27,7 +27,7 @@
 #include "../debugInfo.h"
 #include "../lcs_section.h"
 #include "../symbol.h"
-#include "../dwarf/lineInfo/lineInfo.h"
+#include "../dwarf/lineInfo/lineTable.h"
 
 /**
  * This structure represents an object file.
@@ -66,8 +66,8 @@ struct objectFile {
     
     /** The symbols present in the represented object file.     */
     vector_symbol_t ownSymbols;
-    /** The deducted DWARF line infos.                          */
-    vector_dwarfLineInfo_t lineInfos;
+    /** The deducted DWARF line table.                          */
+    struct dwarf_lineTable lineTable;
     /** The cached name of the main source file.                */
     const char* mainSourceFileCache;
     /** The cached relative name of the main source file.       */
@@ -86,7 +86,8 @@ struct objectFile {
     NULL, NULL, NULL, 0, { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },     \
     lcs_section_initializer, lcs_section_initializer, lcs_section_initializer,   \
     lcs_section_initializer, lcs_section_initializer, lcs_section_initializer,   \
-    false, false, vector_initializer, vector_initializer, NULL, NULL, NULL, NULL \
+    false, false, vector_initializer, dwarf_lineTable_initializer,                \
+    NULL, NULL, NULL, NULL                                                       \
 }
 
 /**
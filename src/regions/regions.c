@@ -31,35 +31,47 @@
 typedef_vector_named(region, struct region);
 
 struct regionInfo regions_getLoadedRegions(void) {
-    if (!dlMapper_init()) {
+    // Explicitly refresh the loaded runtime images, entering a read section does not check them.
+    dlMapper_init();
+    dlMapper_readLock();
+    if (!dlMapper_isInited()) {
+        dlMapper_readUnlock();
         return (struct regionInfo) { NULL, 0 };
     }
 
+    vector_dlMapperRegion_t regions = dlMapper_getLoadedRegions();
     vector_region_t toReturn = vector_initializer;
-    vector_iterate(dlMapper_getLoadedBinaries(), {
-        struct binaryFile* file = *element;
-        vector_iterate(binaryFile_getRegions(file), {
-            vector_push_back(&toReturn, ((struct region) {
-                element->first, element->second,
-                maybe(strdup, file->fileName.absolute),
-                maybe(strdup, file->fileName.relative),
-            }));
-        });
+    vector_reserve(&toReturn, regions.count);
+    vector_iterate(&regions, {
+        vector_push_back(&toReturn, ((struct region) {
+            element->start, element->end,
+            maybe(strdup, element->file->fileName.absolute),
+            maybe(strdup, element->file->fileName.relative),
+        }));
     });
+    vector_destroy(&regions);
+    dlMapper_readUnlock();
 
     maybeV(callstack_clearCaches);
     return (struct regionInfo) { toReturn.content, toReturn.count };
 }
 
 struct regionInfo regions_getTLSRegions(void) {
-    if (!dlMapper_init()) {
+    return regions_getTLSRegionsOf(pthread_self());
+}
+
+struct regionInfo regions_getTLSRegionsOf(const pthread_t thread) {
+    dlMapper_init();
+    dlMapper_readLock();
+    if (!dlMapper_isInited()) {
+        dlMapper_readUnlock();
         return (struct regionInfo) { NULL, 0 };
     }
 
     vector_region_t toReturn = vector_initializer;
     vector_iterate(dlMapper_getLoadedBinaries(), {
         struct binaryFile* file = *element;
-        vector_pair_ptr_t result = binaryFile_getTLSRegions(file);
+        vector_pair_ptr_t result = binaryFile_getTLSRegions(file, thread);
         vector_iterate(&result, {
             vector_push_back(&toReturn, ((struct region) {
                 element->first, element->second,
@@ -69,6 +81,7 @@ struct regionInfo regions_getTLSRegions(void) {
         });
         vector_destroy(&result);
     });
+    dlMapper_readUnlock();
 
     maybeV(callstack_clearCaches);
     return (struct regionInfo) { toReturn.content, toReturn.count };
@@ -35,13 +35,14 @@
  * @return whether a symbol info could be deducted
  */
 static inline bool symbols_getInfoShared(const void* address, SymbolInfo* info, const bool useCache) {
-    dlMapper_init();
+    dlMapper_readLock();
     callstackFrame_translateBinary(info, address, useCache, true);
     struct binaryFile* file = info->reserved;
     bool toReturn = false;
     if (file != NULL) {
         toReturn = binaryFile_getSymbolInfo(file, address, info);
     }
+    dlMapper_readUnlock();
     maybeV(callstack_clearCaches);
     return toReturn;
 }
@@ -0,0 +1,492 @@
+/*
+ * CallstackLibrary - Library creating human-readable call stacks.
+ *
+ * Copyright (C) 2026  mhahnFr
+ *
+ * This file is part of the CallstackLibrary.
+ *
+ * The CallstackLibrary is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The CallstackLibrary is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with the
+ * CallstackLibrary, see the file LICENSE.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifdef __linux__
+# define _GNU_SOURCE
+#endif
+
+#include "unwinder.h"
+
+#if defined(__linux__) && (defined(__x86_64__) || defined(__aarch64__))
+#include <link.h>
+#include <stdatomic.h>
+#include <stddef.h>
+
+#include "../dlMapper/dlMapper.h"
+#include "../parser/file/dwarf/cfi/cfi.h"
+#include "../parser/file/elf/elfFile.h"
+
+#ifdef __x86_64__
+/** The DWARF register number of the stack pointer.   */
+# define UNWINDER_CFI_SP 7
+/** The DWARF register number of the frame pointer.   */
+# define UNWINDER_CFI_FP 6
+/** The DWARF register number of the return address. */
+# define UNWINDER_CFI_RA 16
+
+/**
+ * Captures the registers needed for starting the unwinding.
+ *
+ * @param pc the program counter
+ * @param sp the stack pointer
+ * @param fp the frame pointer
+ * @param ra the return address register
+ */
+# define unwinder_cfi_captureRegisters(pc, sp, fp, ra)                             \
+    __asm__ volatile("leaq 0(%%rip), %0\n\tmovq %%rsp, %1\n\tmovq %%rbp, %2"       \
+                     : "=r" (pc), "=r" (sp), "=r" (fp));                           \
+    (ra) = 0
+
+/**
+ * Removes the pointer authentication code from the given return address.
+ *
+ * @param address the return address
+ * @return the return address without its signature
+ */
+# define unwinder_cfi_stripSignature(address) (address)
+#else
+# define UNWINDER_CFI_SP 31
+# define UNWINDER_CFI_FP 29
+# define UNWINDER_CFI_RA 30
+
+# define unwinder_cfi_captureRegisters(pc, sp, fp, ra)                             \
+    __asm__ volatile("adr %0, .\n\tmov %1, sp\n\tmov %2, x29\n\tmov %3, x30"       \
+                     : "=r" (pc), "=r" (sp), "=r" (fp), "=r" (ra))
+
+static inline uintptr_t unwinder_cfi_stripSignature(const uintptr_t address) {
+    // XPACLRI strips the signature from x30; it is encoded as a hint, which older cores execute as a no-op.
+    register uintptr_t x30 __asm__("x30") = address;
+    __asm__("hint #7" : "+r" (x30));
+    return x30;
+}
+#endif
+
+/** The count of cached frame rules; has to be a power of two. */
+#define UNWINDER_CFI_CACHE_SIZE 1024
+
+/**
+ * The rules needed for stepping through a frame, extracted from a row of the
+ * call frame information table.
+ */
+struct unwinder_cfiFrame {
+    /** The register the CFA is computed from.                        */
+    uint16_t cfaRegister;
+    /** Whether the frame is a signal handler frame.                  */
+    bool signalFrame;
+    /** Whether the return address is signed.                         */
+    bool returnAddressSigned;
+    /** The offset added to the CFA register.                         */
+    int64_t cfaOffset;
+    /** The expression block computing the CFA or @c NULL if not used. */
+    const uint8_t* cfaExpression;
+    /** The rule for restoring the stack pointer.                     */
+    struct dwarf_cfi_rule sp,
+    /** The rule for restoring the frame pointer.                     */
+                          fp,
+    /** The rule for restoring the return address.                    */
+                          ra;
+};
+
+/**
+ * @brief An entry in the cache of frame rules, protected by a sequence lock.
+ *
+ * The entry is tied to the runtime image it was found in by its call frame
+ * information section, which is the runtime image the rules point into.
+ */
+struct unwinder_cfiCacheEntry {
+    /** The sequence number; odd while the entry is written.          */
+    _Atomic uint32_t sequence;
+    /** The generation of the cache the entry was computed in.        */
+    uint32_t generation;
+    /** The program counter the rules belong to.                      */
+    uintptr_t pc;
+    /** The @c .eh_frame_hdr section the rules were found with.       */
+    const void* header;
+    /** The cached rules.                                             */
+    struct unwinder_cfiFrame frame;
+};
+
+/**
+ * Represents the register state of a frame while unwinding.
+ */
+struct unwinder_cfiState {
+    /** The values of the registers.                        */
+    uintptr_t registers[DWARF_CFI_REGISTERS];
+    /** The bit mask of the registers whose value is known. */
+    uint64_t valid;
+};
+
+/** The cache of the frame rules, keyed by the program counter.        */
+static struct unwinder_cfiCacheEntry unwinder_cfiCache[UNWINDER_CFI_CACHE_SIZE];
+/** The current generation; entries of earlier generations are invalid. */
+static _Atomic uint32_t unwinder_cfiCacheGeneration = 1;
+
+/**
+ * Returns the cache entry responsible for the given program counter.
+ *
+ * @param pc the program counter
+ * @return the responsible cache entry
+ */
+static inline struct unwinder_cfiCacheEntry* unwinder_cfi_cacheEntry(const uintptr_t pc) {
+    return &unwinder_cfiCache[(pc * UINT64_C(0x9e3779b97f4a7c15)) >> 54 & (UNWINDER_CFI_CACHE_SIZE - 1)];
+}
+
+/**
+ * Loads the cached rules of the given program counter.
+ *
+ * @param pc the program counter
+ * @param header the @c .eh_frame_hdr section currently responsible for the program counter
+ * @param frame the frame rules to be filled
+ * @return whether the rules were cached
+ */
+static inline bool unwinder_cfi_cacheLoad(const uintptr_t pc, const void* header, struct unwinder_cfiFrame* frame) {
+    struct unwinder_cfiCacheEntry* entry = unwinder_cfi_cacheEntry(pc);
+
+    const uint32_t before = atomic_load_explicit(&entry->sequence, memory_order_acquire);
+    if ((before & 1) != 0 || before == 0) return false;
+
+    const uint32_t generation = entry->generation;
+    const uintptr_t cachedPc  = entry->pc;
+    const void* cachedHeader  = entry->header;
+    *frame = entry->frame;
+    atomic_thread_fence(memory_order_acquire);
+    return cachedPc == pc
+        && cachedHeader == header
+        && generation == atomic_load_explicit(&unwinder_cfiCacheGeneration, memory_order_relaxed)
+        && atomic_load_explicit(&entry->sequence, memory_order_relaxed) == before;
+}
+
+/**
+ * @brief Caches the given rules for the given program counter.
+ *
+ * Nothing is cached if the entry is currently written by someone else or if
+ * the cache has been invalidated since the given generation was read.
+ *
+ * @param pc the program counter
+ * @param header the @c .eh_frame_hdr section the rules were found with
+ * @param generation the generation of the cache read before looking up the rules
+ * @param frame the frame rules to be cached
+ */
+static inline void unwinder_cfi_cacheStore(const uintptr_t pc, const void* header, const uint32_t generation,
+                                           const struct unwinder_cfiFrame* frame) {
+    struct unwinder_cfiCacheEntry* entry = unwinder_cfi_cacheEntry(pc);
+
+    uint32_t sequence = atomic_load_explicit(&entry->sequence, memory_order_relaxed);
+    if (generation != atomic_load_explicit(&unwinder_cfiCacheGeneration, memory_order_acquire)
+        || (sequence & 1) != 0
+        || !atomic_compare_exchange_strong_explicit(&entry->sequence, &sequence, sequence + 1,
+                                                    memory_order_acquire, memory_order_relaxed)) {
+        return;
+    }
+    atomic_thread_fence(memory_order_release);
+    entry->generation = generation;
+    entry->pc         = pc;
+    entry->header     = header;
+    entry->frame      = *frame;
+    atomic_store_explicit(&entry->sequence, sequence + 2, memory_order_release);
+}
+
+void unwinder_cfi_invalidateCache(void) {
+    atomic_fetch_add_explicit(&unwinder_cfiCacheGeneration, 1, memory_order_acq_rel);
+}
+
+/**
+ * @brief Finds the in-memory @c .eh_frame_hdr section responsible for the given
+ * program counter using async-signal-safe functions only.
+ *
+ * @param pc the program counter
+ * @return the @c .eh_frame_hdr section or @c NULL if not found
+ */
+static inline const void* unwinder_cfi_findEHFrameHeaderSignalSafe(const uintptr_t pc) {
+#ifdef DLFO_STRUCT_HAS_EH_DBASE
+    struct dl_find_object object;
+    if (_dl_find_object((void*) pc, &object) == 0) {
+        return object.dlfo_eh_frame;
+    }
+#else
+    (void) pc;
+#endif
+    return NULL;
+}
+
+/**
+ * @brief Finds the in-memory @c .eh_frame_hdr section responsible for the given
+ * program counter.
+ *
+ * If not restricted to async-signal-safe functions, a read section of the
+ * dlMapper needs to be held.
+ *
+ * @param pc the program counter
+ * @param signalSafe whether to only use async-signal-safe functions
+ * @return the @c .eh_frame_hdr section or @c NULL if not found
+ */
+static inline const void* unwinder_cfi_findEHFrameHeader(const uintptr_t pc, const bool signalSafe) {
+    if (signalSafe) {
+        return unwinder_cfi_findEHFrameHeaderSignalSafe(pc);
+    }
+    const struct binaryFile* file = dlMapper_binaryFileForAddress((void*) pc, false);
+    return file == NULL ? NULL : elfFile_getEHFrameHeader((const struct elfFile*) file);
+}
+
+/**
+ * @brief Looks up the frame rules for the given program counter.
+ *
+ * The cached rules are only used if they were found with the call frame
+ * information of the runtime image currently loaded at the program counter.
+ * If not restricted to async-signal-safe functions, a read section of the
+ * dlMapper needs to be held.
+ *
+ * @param pc the program counter
+ * @param frame the frame rules to be filled
+ * @param signalSafe whether to only use async-signal-safe functions
+ * @return whether frame rules were found
+ */
+static inline bool unwinder_cfi_findFrame(const uintptr_t pc, struct unwinder_cfiFrame* frame, const bool signalSafe) {
+    const void* header = unwinder_cfi_findEHFrameHeader(pc, signalSafe);
+    if (header == NULL) {
+        return false;
+    }
+    if (unwinder_cfi_cacheLoad(pc, header, frame)) {
+        return true;
+    }
+
+    const uint32_t generation = atomic_load_explicit(&unwinder_cfiCacheGeneration, memory_order_acquire);
+    struct dwarf_cfi_row row;
+    if (!dwarf_cfi_findRow(header, pc, &row) || row.returnRegister >= DWARF_CFI_REGISTERS) {
+        return false;
+    }
+
+    *frame = (struct unwinder_cfiFrame) {
+        .cfaRegister         = row.cfaRegister,
+        .signalFrame         = row.signalFrame,
+        .returnAddressSigned = row.returnAddressSigned,
+        .cfaOffset           = row.cfaOffset,
+        .cfaExpression       = row.cfaExpression,
+        .sp                  = row.rules[UNWINDER_CFI_SP],
+        .fp                  = row.rules[UNWINDER_CFI_FP],
+        .ra                  = row.rules[row.returnRegister],
+    };
+    unwinder_cfi_cacheStore(pc, header, generation, frame);
+    return true;
+}
+
+/**
+ * Reads a memory word from the stack, verifying it is within the stack bounds.
+ *
+ * @param address the address to read from
+ * @param value the read value
+ * @param args the stack bounds
+ * @return whether the memory word could be read
+ */
+static bool unwinder_cfi_readStack(const uintptr_t address, uintptr_t* value, void* args) {
+    const struct unwinder_stackBounds* bounds = args;
+    if (address % sizeof(uintptr_t) != 0
+        || !unwinder_stackBounds_contains(bounds, address, sizeof(uintptr_t))) {
+        return false;
+    }
+    *value = *(const uintptr_t*) address;
+    return true;
+}
+
+/**
+ * Computes the value of a register in the calling frame using the given rule.
+ *
+ * @param rule the rule of the register
+ * @param reg the DWARF register number
+ * @param cfa the canonical frame address
+ * @param state the register state of the current frame
+ * @param bounds the stack bounds
+ * @param value the restored register value
+ * @return whether the register could be restored
+ */
+static inline bool unwinder_cfi_restore(const struct dwarf_cfi_rule* rule, const uint16_t reg, const uintptr_t cfa,
+                                        const struct unwinder_cfiState* state,
+                                        const struct unwinder_stackBounds* bounds, uintptr_t* value) {
+    uintptr_t address;
+    switch (rule->type) {
+        case DWARF_CFI_RULE_SAME_VALUE:
+            *value = state->registers[reg];
+            return (state->valid & (UINT64_C(1) << reg)) != 0;
+
+        case DWARF_CFI_RULE_OFFSET:
+            return unwinder_cfi_readStack(cfa + rule->value, value, (void*) bounds);
+
+        case DWARF_CFI_RULE_VAL_OFFSET:
+            *value = cfa + rule->value;
+            return true;
+
+        case DWARF_CFI_RULE_REGISTER:
+            if (rule->value < 0 || rule->value >= DWARF_CFI_REGISTERS
+                || (state->valid & (UINT64_C(1) << rule->value)) == 0) {
+                return false;
+            }
+            *value = state->registers[rule->value];
+            return true;
+
+        case DWARF_CFI_RULE_EXPRESSION:
+            return dwarf_cfi_evaluate((const uint8_t*) (uintptr_t) rule->value, state->registers, state->valid,
+                                      cfa, unwinder_cfi_readStack, (void*) bounds, &address)
+                && unwinder_cfi_readStack(address, value, (void*) bounds);
+
+        case DWARF_CFI_RULE_VAL_EXPRESSION:
+            return dwarf_cfi_evaluate((const uint8_t*) (uintptr_t) rule->value, state->registers, state->valid,
+                                      cfa, unwinder_cfi_readStack, (void*) bounds, value);
+
+        default: return false;
+    }
+}
+
+/**
+ * Steps into the calling frame using the given frame rules.
+ *
+ * @param frame the rules of the current frame
+ * @param state the register state, updated to the one of the calling frame
+ * @param bounds the stack bounds
+ * @return whether the calling frame could be restored
+ */
+static inline bool unwinder_cfi_step(const struct unwinder_cfiFrame* frame, struct unwinder_cfiState* state,
+                                     const struct unwinder_stackBounds* bounds) {
+    uintptr_t cfa;
+    if (frame->cfaExpression != NULL) {
+        if (!dwarf_cfi_evaluate(frame->cfaExpression, state->registers, state->valid, 0,
+                                unwinder_cfi_readStack, (void*) bounds, &cfa)) {
+            return false;
+        }
+    } else {
+        if (frame->cfaRegister >= DWARF_CFI_REGISTERS
+            || (state->valid & (UINT64_C(1) << frame->cfaRegister)) == 0) {
+            return false;
+        }
+        cfa = state->registers[frame->cfaRegister] + frame->cfaOffset;
+    }
+
+    uintptr_t sp = cfa, fp, ra;
+    if (!unwinder_cfi_restore(&frame->ra, UNWINDER_CFI_RA, cfa, state, bounds, &ra)
+        || (frame->sp.type != DWARF_CFI_RULE_SAME_VALUE
+            && !unwinder_cfi_restore(&frame->sp, UNWINDER_CFI_SP, cfa, state, bounds, &sp))) {
+        return false;
+    }
+    if (frame->returnAddressSigned) {
+        ra = unwinder_cfi_stripSignature(ra);
+    }
+    const bool fpValid = unwinder_cfi_restore(&frame->fp, UNWINDER_CFI_FP, cfa, state, bounds, &fp);
+
+    state->registers[UNWINDER_CFI_SP] = sp;
+    state->registers[UNWINDER_CFI_RA] = ra;
+    state->valid = UINT64_C(1) << UNWINDER_CFI_SP | UINT64_C(1) << UNWINDER_CFI_RA;
+    if (fpValid) {
+        state->registers[UNWINDER_CFI_FP] = fp;
+        state->valid |= UINT64_C(1) << UNWINDER_CFI_FP;
+    }
+    return true;
+}
+
+/**
+ * Steps into the calling frame by using the frame pointer.
+ *
+ * @param state the register state, updated to the one of the calling frame
+ * @param bounds the stack bounds
+ * @return whether the calling frame could be restored
+ */
+static inline bool unwinder_cfi_stepFramePointer(struct unwinder_cfiState* state,
+                                                 struct unwinder_stackBounds* bounds) {
+    if ((state->valid & (UINT64_C(1) << UNWINDER_CFI_FP)) == 0) return false;
+
+    const uintptr_t fp = state->registers[UNWINDER_CFI_FP];
+    if (fp % sizeof(uintptr_t) != 0
+        || !unwinder_stackBounds_isCaller(bounds, state->registers[UNWINDER_CFI_SP], fp, 2 * sizeof(uintptr_t))) {
+        return false;
+    }
+    const uintptr_t* record = (const uintptr_t*) fp;
+    state->registers[UNWINDER_CFI_SP] = fp + 2 * sizeof(uintptr_t);
+    state->registers[UNWINDER_CFI_FP] = record[0];
+    // Without rules it is unknown whether the return address is signed, stripping an unsigned one is harmless.
+    state->registers[UNWINDER_CFI_RA] = unwinder_cfi_stripSignature(record[1]);
+    state->valid = UINT64_C(1) << UNWINDER_CFI_SP | UINT64_C(1) << UNWINDER_CFI_FP | UINT64_C(1) << UNWINDER_CFI_RA;
+    return true;
+}
+
+__attribute__((noinline))
+int unwinder_cfi(void* buffer[], const int bufferSize, const bool signalSafe) {
+    struct unwinder_stackBounds bounds;
+    if (!unwinder_getStackBounds(&bounds, signalSafe)) {
+        return -1;
+    }
+
+    uintptr_t pc, sp, fp, ra;
+    unwinder_cfi_captureRegisters(pc, sp, fp, ra);
+
+    struct unwinder_cfiState state;
+    state.registers[UNWINDER_CFI_SP] = sp;
+    state.registers[UNWINDER_CFI_FP] = fp;
+    state.registers[UNWINDER_CFI_RA] = ra;
+    state.valid = UINT64_C(1) << UNWINDER_CFI_SP | UINT64_C(1) << UNWINDER_CFI_FP;
+    if (ra != 0) {
+        state.valid |= UINT64_C(1) << UNWINDER_CFI_RA;
+    }
+    if (!unwinder_stackBounds_contains(&bounds, sp, sizeof(uintptr_t))) {
+        return -1;
+    }
+    if (!signalSafe) {
+        // Unloading runtime images invalidates the cache only after the running read sections are left.
+        dlMapper_readLock();
+    }
+
+    // The first program counter is not a return address, it must not be adjusted.
+    bool adjust = false;
+    int i;
+    for (i = 0; i < bufferSize; ++i) {
+        const uintptr_t previousSp = state.registers[UNWINDER_CFI_SP];
+
+        struct unwinder_cfiFrame frame;
+        const bool found = unwinder_cfi_findFrame(pc - adjust, &frame, signalSafe);
+        if (found ? !unwinder_cfi_step(&frame, &state, &bounds)
+                  : !unwinder_cfi_stepFramePointer(&state, &bounds)) {
+            break;
+        }
+
+        const uintptr_t newPc = state.registers[UNWINDER_CFI_RA];
+        const uintptr_t newSp = state.registers[UNWINDER_CFI_SP];
+        if (newPc == 0
+            || (newSp == previousSp && newPc == pc)
+            || !unwinder_stackBounds_isCaller(&bounds, previousSp, newSp, 0)) {
+            break;
+        }
+        buffer[i] = (void*) newPc;
+        pc = newPc;
+        adjust = !found || !frame.signalFrame;
+    }
+    if (!signalSafe) {
+        dlMapper_readUnlock();
+    }
+    return i;
+}
+#else
+int unwinder_cfi(void* buffer[], const int bufferSize, const bool signalSafe) {
+    (void) buffer;
+    (void) bufferSize;
+    (void) signalSafe;
+
+    return -1;
+}
+
+void unwinder_cfi_invalidateCache(void) {}
+#endif
@@ -0,0 +1,200 @@
+/*
+ * CallstackLibrary - Library creating human-readable call stacks.
+ *
+ * Copyright (C) 2026  mhahnFr
+ *
+ * This file is part of the CallstackLibrary.
+ *
+ * The CallstackLibrary is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The CallstackLibrary is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with the
+ * CallstackLibrary, see the file LICENSE.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifdef __linux__
+# define _GNU_SOURCE
+#endif
+
+#include "unwinder.h"
+
+#include <pthread.h>
+#include <signal.h>
+#include <stddef.h>
+
+#include "../lcs_builtins.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(__aarch64__)
+/** The offset of the saved previous frame pointer relative to a frame pointer, in pointers. */
+# define UNWINDER_FP_PREVIOUS_OFFSET 0
+/** The offset of the saved return address relative to a frame pointer, in pointers.        */
+# define UNWINDER_FP_RETURN_OFFSET   1
+#elif defined(__riscv)
+# define UNWINDER_FP_PREVIOUS_OFFSET (-2)
+# define UNWINDER_FP_RETURN_OFFSET   (-1)
+#endif
+
+#ifdef __linux__
+/*
+ * The initial-exec model is used, since accessing a thread local variable of
+ * the general model may allocate, which is not async-signal-safe.
+ */
+# define UNWINDER_THREAD_LOCAL __attribute__((tls_model("initial-exec"))) _Thread_local
+#else
+# define UNWINDER_THREAD_LOCAL _Thread_local
+#endif
+
+/** The cached stack bounds of the current thread.  */
+static UNWINDER_THREAD_LOCAL struct unwinder_stackBounds unwinder_bounds;
+/** Indicates whether the stack bounds are cached.  */
+static UNWINDER_THREAD_LOCAL bool unwinder_boundsLoaded = false;
+
+/**
+ * Queries the bounds of the stack of the calling thread from the system.
+ *
+ * @param bounds the stack bounds structure to be filled
+ * @return whether the bounds could be determined
+ */
+static inline bool unwinder_loadStackBounds(struct unwinder_stackBounds* bounds) {
+    bounds->alternateLow  = 0;
+    bounds->alternateHigh = 0;
+#ifdef __APPLE__
+    const pthread_t self = pthread_self();
+    const uintptr_t high = (uintptr_t) pthread_get_stackaddr_np(self);
+    bounds->low  = high - pthread_get_stacksize_np(self);
+    bounds->high = high;
+    return true;
+#elif defined(__linux__)
+    pthread_attr_t attributes;
+    if (pthread_getattr_np(pthread_self(), &attributes) != 0) {
+        return false;
+    }
+    void* address;
+    size_t size;
+    const bool success = pthread_attr_getstack(&attributes, &address, &size) == 0;
+    pthread_attr_destroy(&attributes);
+    if (success) {
+        bounds->low  = (uintptr_t) address;
+        bounds->high = (uintptr_t) address + size;
+    }
+    return success;
+#else
+    (void) bounds;
+    return false;
+#endif
+}
+
+/**
+ * @brief Adds the alternate signal stack to the given bounds if it is currently
+ * executing on it.
+ *
+ * This function is async-signal-safe.
+ *
+ * @param bounds the stack bounds to be completed
+ */
+static inline void unwinder_loadAlternateStack(struct unwinder_stackBounds* bounds) {
+    bounds->alternateLow  = 0;
+    bounds->alternateHigh = 0;
+
+    stack_t stack;
+    if (sigaltstack(NULL, &stack) == 0 && (stack.ss_flags & SS_ONSTACK) != 0) {
+        bounds->alternateLow  = (uintptr_t) stack.ss_sp;
+        bounds->alternateHigh = (uintptr_t) stack.ss_sp + stack.ss_size;
+    }
+}
+
+/**
+ * @brief Loads the stack bounds of the calling thread using async-signal-safe
+ * functions only.
+ *
+ * Thread local variables are not touched on Apple platforms, since their first
+ * access allocates there.
+ *
+ * @param bounds the stack bounds structure to be filled
+ * @return whether the bounds could be determined
+ */
+static inline bool unwinder_getStackBoundsSignalSafe(struct unwinder_stackBounds* bounds) {
+#ifdef __APPLE__
+    if (!unwinder_loadStackBounds(bounds)) {
+        return false;
+    }
+#else
+    if (unwinder_boundsLoaded) {
+        *bounds = unwinder_bounds;
+    } else {
+        bounds->low  = (uintptr_t) lcs_frameAddress(0);
+        bounds->high = bounds->low == 0 ? 0 : bounds->low + UNWINDER_STACK_ESTIMATE;
+    }
+#endif
+    unwinder_loadAlternateStack(bounds);
+    if (bounds->alternateHigh != 0 && bounds->low >= bounds->alternateLow && bounds->low < bounds->alternateHigh) {
+        // The estimation was based on the alternate signal stack.
+        bounds->low  = 0;
+        bounds->high = 0;
+    }
+    return bounds->high != 0 || bounds->alternateHigh != 0;
+}
+
+bool unwinder_getStackBounds(struct unwinder_stackBounds* bounds, const bool signalSafe) {
+    if (signalSafe) {
+        return unwinder_getStackBoundsSignalSafe(bounds);
+    }
+    if (!unwinder_boundsLoaded) {
+        unwinder_boundsLoaded = unwinder_loadStackBounds(&unwinder_bounds);
+        if (!unwinder_boundsLoaded) {
+            return false;
+        }
+    }
+    *bounds = unwinder_bounds;
+    return true;
+}
+
+#if defined(LCS_USE_BUILTINS) && defined(UNWINDER_FP_RETURN_OFFSET)
+__attribute__((noinline))
+int unwinder_framePointer(void* buffer[], const int bufferSize, const bool signalSafe) {
+    struct unwinder_stackBounds bounds;
+    if (!unwinder_getStackBounds(&bounds, signalSafe)) {
+        return -1;
+    }
+
+    const uintptr_t frameSize = 2 * sizeof(void*);
+    void** frame = lcs_frameAddress(0);
+    if (!unwinder_stackBounds_contains(&bounds, (uintptr_t) (frame + UNWINDER_FP_PREVIOUS_OFFSET), frameSize)) {
+        return -1;
+    }
+
+    int i;
+    for (i = 0; i < bufferSize; ++i) {
+        void* const returnAddress = frame[UNWINDER_FP_RETURN_OFFSET];
+        if (returnAddress == NULL) break;
+
+        buffer[i] = returnAddress;
+
+        void** const previous = frame[UNWINDER_FP_PREVIOUS_OFFSET];
+        if (previous == frame
+            || (uintptr_t) previous % sizeof(void*) != 0
+            || !unwinder_stackBounds_isCaller(&bounds, (uintptr_t) (frame + UNWINDER_FP_PREVIOUS_OFFSET),
+                                              (uintptr_t) (previous + UNWINDER_FP_PREVIOUS_OFFSET), frameSize)) {
+            ++i;
+            break;
+        }
+        frame = previous;
+    }
+    return i;
+}
+#else
+int unwinder_framePointer(void* buffer[], const int bufferSize, const bool signalSafe) {
+    (void) buffer;
+    (void) bufferSize;
+    (void) signalSafe;
+
+    return -1;
+}
+#endif
@@ -0,0 +1,147 @@
+/*
+ * CallstackLibrary - Library creating human-readable call stacks.
+ *
+ * Copyright (C) 2026  mhahnFr
+ *
+ * This file is part of the CallstackLibrary.
+ *
+ * The CallstackLibrary is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The CallstackLibrary is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with the
+ * CallstackLibrary, see the file LICENSE.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef unwinder_h
+#define unwinder_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** The size assumed for a stack whose bounds cannot be determined. */
+#define UNWINDER_STACK_ESTIMATE (64 * 1024)
+
+/**
+ * Represents the bounds of a stack.
+ */
+struct unwinder_stackBounds {
+    /** The lowest address belonging to the stack.                            */
+    uintptr_t low;
+    /** The first address no longer belonging to the stack; @c 0 if unknown.  */
+    uintptr_t high;
+    /** The lowest address of the alternate signal stack currently executing. */
+    uintptr_t alternateLow;
+    /** The end of the alternate signal stack; @c 0 if not executing on it.   */
+    uintptr_t alternateHigh;
+};
+
+/**
+ * @brief Loads the bounds of the stack of the calling thread.
+ *
+ * The bounds are cached per thread.<br>
+ * In the async-signal-safe mode, the system is only queried for the alternate
+ * signal stack. If the bounds have not been cached before, a stack of
+ * @c UNWINDER_STACK_ESTIMATE bytes above the current stack pointer is assumed.
+ *
+ * @param bounds the stack bounds structure to be filled
+ * @param signalSafe whether to only use async-signal-safe functions
+ * @return whether the bounds could be determined
+ */
+bool unwinder_getStackBounds(struct unwinder_stackBounds* bounds, bool signalSafe);
+
+/**
+ * Returns whether the given stack bounds contain the given address range.
+ *
+ * @param bounds the stack bounds
+ * @param address the start address of the range
+ * @param size the size of the range in bytes
+ * @return whether the given range lies completely within the given bounds
+ */
+static inline bool unwinder_stackBounds_contains(const struct unwinder_stackBounds* bounds,
+                                                 const uintptr_t address, const uintptr_t size) {
+    return (address >= bounds->low && address < bounds->high && bounds->high - address >= size)
+        || (address >= bounds->alternateLow && address < bounds->alternateHigh
+            && bounds->alternateHigh - address >= size);
+}
+
+/**
+ * @brief Returns whether the given address range may belong to a calling frame
+ * of the frame at the given address.
+ *
+ * The stack grows downwards, the calling frame therefore needs to lie above
+ * the current one, unless the current frame is on the alternate signal stack
+ * and the calling one is on the regular stack. If the bounds of the regular
+ * stack are unknown in that case, they are estimated from the given address.
+ *
+ * @param bounds the stack bounds
+ * @param current the address of the current frame
+ * @param address the start address of the range of the calling frame
+ * @param size the size of the range in bytes
+ * @return whether the given range is a valid calling frame
+ */
+static inline bool unwinder_stackBounds_isCaller(struct unwinder_stackBounds* bounds, const uintptr_t current,
+                                                 const uintptr_t address, const uintptr_t size) {
+    const bool currentAlternate = current >= bounds->alternateLow && current < bounds->alternateHigh;
+    if (currentAlternate && bounds->high == 0
+        && (address < bounds->alternateLow || address >= bounds->alternateHigh)) {
+        bounds->low  = address;
+        bounds->high = address + UNWINDER_STACK_ESTIMATE;
+    }
+    if (!unwinder_stackBounds_contains(bounds, address, size)) {
+        return false;
+    }
+    return address >= current
+        || (currentAlternate && (address < bounds->alternateLow || address >= bounds->alternateHigh));
+}
+
+/**
+ * @brief Creates a backtrace by walking the chain of frame pointers.
+ *
+ * The first stored address is the return address of this function. Every
+ * frame is checked against the bounds of the stack of the calling thread
+ * before it is dereferenced.
+ *
+ * @param buffer the buffer to store the frame addresses in
+ * @param bufferSize the count of available elements in the given buffer
+ * @param signalSafe whether to only use async-signal-safe functions
+ * @return the count of frame addresses stored in the given buffer or @c -1 if
+ * the frame pointers cannot be walked
+ */
+int unwinder_framePointer(void* buffer[], int bufferSize, bool signalSafe);
+
+/**
+ * @brief Creates a backtrace by interpreting the DWARF call frame information.
+ *
+ * The first stored address is the return address of this function. The call
+ * frame information is taken from the in-memory @c .eh_frame_hdr sections of
+ * the loaded ELF binaries; the rules of each frame are cached by the program
+ * counter. Frames without call frame information are stepped using the frame
+ * pointer.<br>
+ * In the async-signal-safe mode, uncached rules are only looked up if the
+ * system provides an async-signal-safe way of finding the @c .eh_frame_hdr
+ * section of a program counter.
+ *
+ * @param buffer the buffer to store the frame addresses in
+ * @param bufferSize the count of available elements in the given buffer
+ * @param signalSafe whether to only use async-signal-safe functions
+ * @return the count of frame addresses stored in the given buffer or @c -1 if
+ * the call frame information cannot be used
+ */
+int unwinder_cfi(void* buffer[], int bufferSize, bool signalSafe);
+
+/**
+ * @brief Invalidates all cached frame rules.
+ *
+ * Needs to be called when runtime images have been unloaded, since the cached
+ * rules refer to their memory.
+ */
+void unwinder_cfi_invalidateCache(void);
+
+#endif /* unwinder_h */
@@ -22,7 +22,7 @@
 #ifndef CALLSTACKLIBRARY_CACHE_H
 #define CALLSTACKLIBRARY_CACHE_H
 
-#include <callstack_internals.h>
+#include "../../parser/callstack_parser.h"
 
 /**
  * Executes the given function, passing the given arguments if the given
@@ -45,20 +45,22 @@
 #define maybeRunV(b, func) ((b) ? (func)() : (void) NULL)
 
 /**
- * Executes the given function if @c callstack_autoClearCaches is @c true .
+ * Executes the given function if the caches are cleared automatically by the
+ * calling thread.
  *
  * @param func the function to possibly execute
  * @param ... the arguments to pass to the given function
  * @return the return value of the function or the given arguments
  */
-#define maybe(func, ...) maybeRun(callstack_autoClearCaches, func, __VA_ARGS__)
+#define maybe(func, ...) maybeRun(callstack_parser_clearsCaches(), func, __VA_ARGS__)
 
 /**
- * Executes the given function if @c callstack_autoClearCaches is @c true .
+ * Executes the given function if the caches are cleared automatically by the
+ * calling thread.
  *
  * @param func the function to possibly execute
  * @return the return value of the given function or @c NULL
  */
-#define maybeV(func) maybeRunV(callstack_autoClearCaches, func)
+#define maybeV(func) maybeRunV(callstack_parser_clearsCaches(), func)
 
 #endif //CALLSTACKLIBRARY_CACHE_H
\ No newline at end of file
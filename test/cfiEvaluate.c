@@ -0,0 +1,148 @@
+/*
+ * CallstackLibrary - Library creating human-readable call stacks.
+ *
+ * Copyright (C) 2026  mhahnFr
+ *
+ * This file is part of the CallstackLibrary.
+ *
+ * The CallstackLibrary is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The CallstackLibrary is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with the
+ * CallstackLibrary, see the file LICENSE.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <stdio.h>
+#include <string.h>
+
+#include "parser/file/dwarf/cfi/cfi.h"
+#include "parser/file/dwarf/cfi/definitions.h"
+
+/** The count of failed checks. */
+static size_t fails = 0;
+
+/**
+ * Reads memory by returning the address incremented by one.
+ *
+ * @param address the address to be read
+ * @param value the value to be filled
+ * @param args unused
+ * @return always @c true
+ */
+static bool readMemory(const uintptr_t address, uintptr_t* value, void* args) {
+    (void) args;
+
+    *value = address + 1;
+    return true;
+}
+
+/**
+ * Evaluates the given operations, prefixed by their length, and checks the
+ * outcome.
+ *
+ * @param what the name of the check
+ * @param operations the operations
+ * @param length the amount of bytes of the operations
+ * @param registers the values of the registers
+ * @param valid the bit mask of the valid registers
+ * @param succeeds whether the evaluation is expected to succeed
+ * @param expected the expected result
+ */
+static void check(const char* what, const uint8_t* operations, const size_t length,
+                  const uintptr_t registers[DWARF_CFI_REGISTERS], const uint64_t valid,
+                  const bool succeeds, const uintptr_t expected) {
+    uint8_t expression[64] = { (uint8_t) length };
+    memcpy(expression + 1, operations, length);
+
+    uintptr_t result = 0;
+    const bool evaluated = dwarf_cfi_evaluate(expression, registers, valid, 0, readMemory, NULL, &result);
+    if (evaluated != succeeds || (evaluated && result != expected)) {
+        printf("%s: evaluated %d, 0x%llx, expected %d, 0x%llx\n", what, evaluated,
+               (unsigned long long) result, succeeds, (unsigned long long) expected);
+        ++fails;
+    }
+}
+
+/** Checks the given operations to evaluate to the given value. */
+#define CHECK(what, expected, ...) do {                                            \
+    const uint8_t operations[] = { __VA_ARGS__ };                                 \
+    check(what, operations, sizeof(operations), registers, valid, true, expected); \
+} while (0)
+
+/** Checks the evaluation of the given operations to fail. */
+#define CHECK_FAILS(what, ...) do {                                           \
+    const uint8_t operations[] = { __VA_ARGS__ };                            \
+    check(what, operations, sizeof(operations), registers, valid, false, 0); \
+} while (0)
+
+/** Pushes the given value of up to 32 bits. */
+#define CONST(value) DW_OP_const4u, (value) & 0xff, ((value) >> 8) & 0xff, ((value) >> 16) & 0xff, (value) >> 24
+
+int main(void) {
+    uintptr_t registers[DWARF_CFI_REGISTERS] = { 0 };
+    registers[7]  = 0x7ffc1000;
+    registers[16] = 0x401025;
+    const uint64_t valid = UINT64_C(1) << 7 | UINT64_C(1) << 16;
+
+    // The CFA expression of the x86-64 .plt section.
+    const uint8_t plt[] = {
+        DW_OP_breg0 + 7, 8, DW_OP_breg0 + 16, 0, DW_OP_lit0 + 15, DW_OP_and, DW_OP_lit0 + 11, DW_OP_ge,
+        DW_OP_lit0 + 3, DW_OP_shl, DW_OP_plus
+    };
+    check("plt before push", plt, sizeof(plt), registers, valid, true, 0x7ffc1008);
+    registers[16] = 0x40102b;
+    check("plt after push", plt, sizeof(plt), registers, valid, true, 0x7ffc1010);
+    check("plt without rip", plt, sizeof(plt), registers, UINT64_C(1) << 7, false, 0);
+
+    CHECK("and",   0x0f00, CONST(0xff00), CONST(0x0ff0), DW_OP_and);
+    CHECK("or",    0xfff0, CONST(0xff00), CONST(0x0ff0), DW_OP_or);
+    CHECK("xor",   0xf0f0, CONST(0xff00), CONST(0x0ff0), DW_OP_xor);
+    CHECK("minus", (uintptr_t) -3, DW_OP_lit0 + 2, DW_OP_lit0 + 5, DW_OP_minus);
+    CHECK("shl",   0x50, DW_OP_lit0 + 5, DW_OP_lit0 + 4, DW_OP_shl);
+    CHECK("shr",   0x5, CONST(0x50), DW_OP_lit0 + 4, DW_OP_shr);
+    CHECK("shl overlong", 0, DW_OP_lit0 + 5, DW_OP_const1u, 200, DW_OP_shl);
+    CHECK("shr overlong", 0, DW_OP_lit0 + 5, DW_OP_const1u, 200, DW_OP_shr);
+    CHECK("shr negative", UINTPTR_MAX >> 4, DW_OP_const1s, 0xf0, DW_OP_lit0 + 4, DW_OP_shr);
+    CHECK("shra",  (uintptr_t) -1, DW_OP_const1s, 0xf0, DW_OP_lit0 + 4, DW_OP_shra);
+    CHECK("shra overlong", (uintptr_t) -1, DW_OP_const1s, 0xf0, DW_OP_const1u, 200, DW_OP_shra);
+
+    CHECK("eq",  1, DW_OP_lit0 + 3, DW_OP_lit0 + 3, DW_OP_eq);
+    CHECK("ne",  0, DW_OP_lit0 + 3, DW_OP_lit0 + 3, DW_OP_ne);
+    CHECK("ge",  1, DW_OP_lit0 + 3, DW_OP_lit0 + 3, DW_OP_ge);
+    CHECK("gt",  0, DW_OP_lit0 + 3, DW_OP_lit0 + 3, DW_OP_gt);
+    CHECK("le",  1, DW_OP_lit0 + 2, DW_OP_lit0 + 3, DW_OP_le);
+    CHECK("lt",  1, DW_OP_lit0 + 2, DW_OP_lit0 + 3, DW_OP_lt);
+    CHECK("signed lt", 1, DW_OP_const1s, 0xff, DW_OP_lit0 + 1, DW_OP_lt);
+    CHECK("signed gt", 0, DW_OP_const1s, 0xff, DW_OP_lit0 + 1, DW_OP_gt);
+
+    CHECK("dup",  6, DW_OP_lit0 + 3, DW_OP_dup, DW_OP_plus);
+    CHECK("drop", 3, DW_OP_lit0 + 3, DW_OP_lit0 + 4, DW_OP_drop);
+    CHECK("over", 3, DW_OP_lit0 + 3, DW_OP_lit0 + 4, DW_OP_over);
+    CHECK("swap", (uintptr_t) -1, DW_OP_lit0 + 5, DW_OP_lit0 + 4, DW_OP_swap, DW_OP_minus);
+    CHECK("deref", 0x7ffc1009, DW_OP_breg0 + 7, 8, DW_OP_deref);
+
+    // The initial value is the only entry of the stack.
+    CHECK("initial", 0, DW_OP_dup, DW_OP_drop);
+    CHECK_FAILS("empty",            DW_OP_drop);
+    CHECK_FAILS("drop underflow",   DW_OP_drop, DW_OP_drop);
+    CHECK_FAILS("dup underflow",    DW_OP_drop, DW_OP_dup);
+    CHECK_FAILS("deref underflow",  DW_OP_drop, DW_OP_deref);
+    CHECK_FAILS("uconst underflow", DW_OP_drop, DW_OP_plus_uconst, 1);
+    CHECK_FAILS("swap underflow",   DW_OP_swap);
+    CHECK_FAILS("over underflow",   DW_OP_over);
+    CHECK_FAILS("binary underflow", DW_OP_and);
+    CHECK_FAILS("overflow",         DW_OP_dup, DW_OP_dup, DW_OP_dup, DW_OP_dup, DW_OP_dup, DW_OP_dup, DW_OP_dup,
+                                    DW_OP_dup);
+    CHECK_FAILS("unsupported",      DW_OP_lit0, 0x97);
+
+    printf("CFI expressions: %zu failures\n", fails);
+    return fails != 0;
+}
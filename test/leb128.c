@@ -0,0 +1,347 @@
+/*
+ * CallstackLibrary - Library creating human-readable call stacks.
+ *
+ * Copyright (C) 2026  mhahnFr
+ *
+ * This file is part of the CallstackLibrary.
+ *
+ * The CallstackLibrary is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The CallstackLibrary is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with the
+ * CallstackLibrary, see the file LICENSE.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "parser/file/dwarf/leb128.h"
+
+/** The count of failed checks. */
+static size_t fails = 0;
+
+/** The count of encoded numbers decoded by the benchmark.     */
+#define BENCHMARK_NUMBERS (1 << 16)
+/** The count of times the encoded numbers are decoded.        */
+#define BENCHMARK_ROUNDS  200
+
+/**
+ * Reports a failed check.
+ *
+ * @param what the kind of the check
+ * @param value the checked value
+ */
+static void fail(const char* what, const uint64_t value) {
+    if (fails++ < 10) {
+        printf("%s failed for 0x%llx\n", what, (unsigned long long) value);
+    }
+}
+
+/**
+ * Encodes the given unsigned value, padded to at least the given amount of bytes.
+ *
+ * @param value the value to be encoded
+ * @param out the buffer to be filled
+ * @param pad the minimal amount of bytes to be used
+ * @return the amount of bytes used
+ */
+static size_t encodeULEB128(uint64_t value, uint8_t* out, const size_t pad) {
+    size_t count = 0;
+    do {
+        uint8_t byte = value & 0x7f;
+        value >>= 7;
+        if (value != 0 || pad > count + 1) {
+            byte |= 0x80;
+        }
+        out[count++] = byte;
+    } while (value != 0 || count < pad);
+    return count;
+}
+
+/**
+ * Encodes the given signed value.
+ *
+ * @param value the value to be encoded
+ * @param out the buffer to be filled
+ * @return the amount of bytes used
+ */
+static size_t encodeLEB128(int64_t value, uint8_t* out) {
+    size_t count = 0;
+    for (;;) {
+        const uint8_t byte = value & 0x7f;
+        value >>= 7;
+        if ((value == 0 && (byte & 0x40) == 0) || (value == -1 && (byte & 0x40) != 0)) {
+            out[count++] = byte;
+            return count;
+        }
+        out[count++] = byte | 0x80;
+    }
+}
+
+/**
+ * Checks the round trip of the given unsigned value, including every
+ * truncation of its encoding for the bounded decoder.
+ *
+ * @param value the value
+ * @param pad the minimal amount of bytes of the encoding
+ */
+static void checkULEB128(const uint64_t value, const size_t pad) {
+    uint8_t buffer[32] = { 0xaa };
+    const size_t length = encodeULEB128(value, buffer + 1, pad);
+
+    size_t counter = 1;
+    if (getULEB128(buffer, &counter) != value || counter != length + 1) {
+        fail("ULEB128", value);
+    }
+    for (size_t size = 1; size <= length + 1; ++size) {
+        uint64_t result = 0;
+        counter = 1;
+        const bool decoded = getULEB128Bounded(buffer, size, &counter, &result);
+        if (decoded != (size == length + 1)
+            || (decoded && (result != value || counter != length + 1))
+            || (!decoded && counter != 1)) {
+            fail("bounded ULEB128", value);
+        }
+    }
+}
+
+/**
+ * Checks the round trip of the given signed value, including a truncation of
+ * its encoding for the bounded decoder.
+ *
+ * @param value the value
+ */
+static void checkLEB128(const int64_t value) {
+    uint8_t buffer[32] = { 0 };
+    const size_t length = encodeLEB128(value, buffer + 2);
+
+    size_t counter = 2;
+    if (getLEB128(buffer, &counter) != value || counter != length + 2) {
+        fail("LEB128", (uint64_t) value);
+    }
+    int64_t result;
+    counter = 2;
+    if (!getLEB128Bounded(buffer, length + 2, &counter, &result) || result != value || counter != length + 2) {
+        fail("bounded LEB128", (uint64_t) value);
+    }
+    counter = 2;
+    if (getLEB128Bounded(buffer, length + 1, &counter, &result) || counter != 2) {
+        fail("truncated LEB128", (uint64_t) value);
+    }
+}
+
+/**
+ * Checks the decoding of every byte sequence of up to three bytes against a
+ * reference decoding.
+ */
+static void checkSequences(void) {
+    for (uint32_t bits = 0; bits < 1 << 24; ++bits) {
+        const uint8_t bytes[4] = { bits & 0xff, (bits >> 8) & 0xff, bits >> 16, 0 };
+        const size_t length = bytes[0] < 0x80 ? 1 : bytes[1] < 0x80 ? 2 : bytes[2] < 0x80 ? 3 : 0;
+        if (length == 0) continue;
+
+        uint64_t expected = 0;
+        for (size_t i = 0; i < length; ++i) {
+            expected |= (uint64_t) (bytes[i] & 0x7f) << (7 * i);
+        }
+        int64_t expectedSigned = (int64_t) expected;
+        if ((bytes[length - 1] & 0x40) != 0) {
+            expectedSigned = (int64_t) (expected | ~UINT64_C(0) << (7 * length));
+        }
+        size_t counter = 0, signedCounter = 0;
+        if (getULEB128(bytes, &counter) != expected || counter != length
+            || getLEB128(bytes, &signedCounter) != expectedSigned || signedCounter != length) {
+            fail("sequence", bits);
+        }
+    }
+}
+
+/**
+ * Returns a pseudo-random number.
+ *
+ * @return the next pseudo-random number
+ */
+static uint64_t nextRandom(void) {
+    static uint64_t state = UINT64_C(88172645463325252);
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+/**
+ * Decodes an unsigned LEB128 number one byte per iteration out of line, like
+ * the decoder replaced by the fast path did.
+ *
+ * @param begin the memory to decode from
+ * @param counter the offset into the memory, advanced past the number
+ * @return the decoded number
+ */
+__attribute__((noinline))
+static uint64_t loopULEB128(const void* begin, size_t* counter) {
+    uint64_t result = 0;
+    unsigned shift  = 0;
+    uint8_t byte;
+    do {
+        byte = *(const uint8_t*) (begin + (*counter)++);
+        result |= (uint64_t) (byte & 0x7f) << shift;
+        shift += 7;
+    } while (byte >= 0x80);
+    return result;
+}
+
+/**
+ * Decodes a signed LEB128 number one byte per iteration out of line, like the
+ * decoder replaced by the fast path did.
+ *
+ * @param begin the memory to decode from
+ * @param counter the offset into the memory, advanced past the number
+ * @return the decoded number
+ */
+__attribute__((noinline))
+static int64_t loopLEB128(const void* begin, size_t* counter) {
+    uint64_t result = 0;
+    unsigned shift  = 0;
+    uint8_t byte;
+    do {
+        byte = *(const uint8_t*) (begin + (*counter)++);
+        result |= (uint64_t) (byte & 0x7f) << shift;
+        shift += 7;
+    } while (byte >= 0x80);
+    if (shift < 64 && (byte & 0x40) != 0) {
+        result |= ~UINT64_C(0) << shift;
+    }
+    return (int64_t) result;
+}
+
+/**
+ * Returns the seconds passed since the given time.
+ *
+ * @param begin the time to measure from
+ * @return the passed seconds
+ */
+static double secondsSince(const struct timespec* begin) {
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (double) (end.tv_sec - begin->tv_sec) + (double) (end.tv_nsec - begin->tv_nsec) / 1e9;
+}
+
+/**
+ * Decodes the given encoded numbers repeatedly with the given decoder.
+ *
+ * @param decode the decoder, called directly to allow it to be inlined
+ * @param buffer the encoded numbers
+ * @param length the length of the encoded numbers in bytes
+ * @param sum the sum of the decoded numbers to be filled
+ * @param seconds the needed seconds to be filled
+ */
+#define MEASURE(decode, buffer, length, sum, seconds) do {            \
+    struct timespec begin;                                          \
+    clock_gettime(CLOCK_MONOTONIC, &begin);                         \
+    for (size_t round = 0; round < BENCHMARK_ROUNDS; ++round) {     \
+        for (size_t counter = 0; counter < (length);) {             \
+            (sum) += (uint64_t) decode((buffer), &counter);         \
+        }                                                           \
+    }                                                               \
+    (seconds) = secondsSince(&begin);                               \
+} while (0)
+
+/**
+ * Reports the measured decoding speeds, both decoders have to yield the same
+ * sum of the numbers.
+ *
+ * @param what the kind of the numbers
+ * @param fastSum the sum of the numbers decoded by the library
+ * @param fastSeconds the seconds needed by the library
+ * @param loopSum the sum of the numbers decoded by the byte loop
+ * @param loopSeconds the seconds needed by the byte loop
+ */
+static void report(const char* what, const uint64_t fastSum, const double fastSeconds,
+                   const uint64_t loopSum, const double loopSeconds) {
+    if (fastSum != loopSum) {
+        fail("benchmark sum", fastSum);
+    }
+    const double numbers = (double) BENCHMARK_NUMBERS * BENCHMARK_ROUNDS / 1e6;
+    printf("  %-8s %7.1f M/s, byte loop %7.1f M/s, %.2fx\n", what, numbers / fastSeconds, numbers / loopSeconds,
+           loopSeconds / fastSeconds);
+}
+
+/**
+ * @brief Measures the decoding speed against a decoder decoding one byte per
+ * iteration.
+ *
+ * Most of the numbers fit into a single byte, as in the line programs and
+ * abbreviation tables, the others are up to five bytes long.
+ */
+static void benchmarks(void) {
+    uint8_t* unsignedBuffer = malloc(BENCHMARK_NUMBERS * 10);
+    uint8_t* signedBuffer   = malloc(BENCHMARK_NUMBERS * 10);
+    if (unsignedBuffer == NULL || signedBuffer == NULL) {
+        fail("benchmark allocation", 0);
+        free(unsignedBuffer);
+        free(signedBuffer);
+        return;
+    }
+    size_t unsignedLength = 0, signedLength = 0;
+    for (size_t i = 0; i < BENCHMARK_NUMBERS; ++i) {
+        const uint64_t random = nextRandom();
+        const unsigned bits = random % 8 < 6 ? 6 : 7 + (unsigned) (random >> 8) % 28;
+        const uint64_t value = (random >> 32) & ((UINT64_C(1) << bits) - 1);
+        unsignedLength += encodeULEB128(value, unsignedBuffer + unsignedLength, 0);
+        signedLength   += encodeLEB128((random & 1) != 0 ? -(int64_t) value : (int64_t) value,
+                                       signedBuffer + signedLength);
+    }
+    uint64_t fastSum = 0, loopSum = 0;
+    double fastSeconds, loopSeconds;
+    printf("LEB128 decoding, mostly single bytes:\n");
+    MEASURE(getULEB128,  unsignedBuffer, unsignedLength, fastSum, fastSeconds);
+    MEASURE(loopULEB128, unsignedBuffer, unsignedLength, loopSum, loopSeconds);
+    report("unsigned", fastSum, fastSeconds, loopSum, loopSeconds);
+
+    fastSum = loopSum = 0;
+    MEASURE(getLEB128,  signedBuffer, signedLength, fastSum, fastSeconds);
+    MEASURE(loopLEB128, signedBuffer, signedLength, loopSum, loopSeconds);
+    report("signed", fastSum, fastSeconds, loopSum, loopSeconds);
+    free(unsignedBuffer);
+    free(signedBuffer);
+}
+
+int main(void) {
+    for (uint64_t value = 0; value < 1 << 21; ++value) {
+        checkULEB128(value, 0);
+    }
+    for (int64_t value = -(1 << 20); value < 1 << 20; ++value) {
+        checkLEB128(value);
+    }
+    checkSequences();
+
+    // The boundaries of every encoded length and overlong encodings.
+    for (unsigned shift = 0; shift < 64; ++shift) {
+        const uint64_t power = UINT64_C(1) << shift;
+        const uint64_t values[] = { power - 1, power, power + 1, ~power, ~(power - 1) };
+        for (size_t i = 0; i < sizeof(values) / sizeof(*values); ++i) {
+            checkULEB128(values[i], 0);
+            checkULEB128(values[i] & 0x3fff, 10);
+            checkLEB128((int64_t) values[i]);
+        }
+    }
+    checkULEB128(UINT64_MAX, 0);
+    checkLEB128(INT64_MIN);
+    checkLEB128(INT64_MAX);
+
+    for (size_t i = 0; i < 1000000; ++i) {
+        checkULEB128(nextRandom() >> nextRandom() % 64, 0);
+        checkLEB128((int64_t) nextRandom() >> nextRandom() % 64);
+    }
+    benchmarks();
+    printf("LEB128: %zu failures\n", fails);
+    return fails != 0;
+}
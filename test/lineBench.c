@@ -0,0 +1,171 @@
+/*
+ * CallstackLibrary - Library creating human-readable call stacks.
+ *
+ * Copyright (C) 2026  mhahnFr
+ *
+ * This file is part of the CallstackLibrary.
+ *
+ * The CallstackLibrary is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The CallstackLibrary is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with the
+ * CallstackLibrary, see the file LICENSE.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+/*
+ * Measures the line table rows decoded per second from the .debug_line
+ * section of the given ELF file, this test program itself by default.
+ */
+
+#include <elf.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "parser/file/dwarf/parser.h"
+
+/** The minimal time to decode the line programs repeatedly for, in seconds. */
+#define MINIMUM_TIME 0.2
+
+/**
+ * The sections needed for decoding the line programs.
+ */
+struct sections {
+    /** The @c .debug_line section.        */
+    struct lcs_section debugLine,
+    /** The @c .debug_line_str section.    */
+                       debugLineStr,
+    /** The @c .debug_str section.         */
+                       debugStr,
+    /** The @c .debug_info section.        */
+                       debugInfo,
+    /** The @c .debug_abbrev section.      */
+                       debugAbbrev,
+    /** The @c .debug_str_offsets section. */
+                       debugStrOffsets;
+};
+
+/**
+ * Finds the DWARF sections in the given mapped 64 bit ELF file.
+ *
+ * @param file the mapped file
+ * @param size the size of the mapped file
+ * @param sections the sections to be filled
+ * @return whether the file is a 64 bit ELF file
+ */
+static bool findSections(const uint8_t* file, const size_t size, struct sections* sections) {
+    const Elf64_Ehdr* header = (const Elf64_Ehdr*) file;
+    if (size < sizeof(Elf64_Ehdr) || memcmp(header->e_ident, ELFMAG, SELFMAG) != 0
+        || header->e_ident[EI_CLASS] != ELFCLASS64 || header->e_shoff + header->e_shnum * sizeof(Elf64_Shdr) > size
+        || header->e_shstrndx >= header->e_shnum) {
+        return false;
+    }
+    const Elf64_Shdr* sectionHeaders = (const Elf64_Shdr*) (file + header->e_shoff);
+    const char* names = (const char*) file + sectionHeaders[header->e_shstrndx].sh_offset;
+    const struct {
+        const char* name;
+        struct lcs_section* section;
+    } wanted[] = {
+        { ".debug_line",        &sections->debugLine       },
+        { ".debug_line_str",    &sections->debugLineStr    },
+        { ".debug_str",         &sections->debugStr        },
+        { ".debug_info",        &sections->debugInfo       },
+        { ".debug_abbrev",      &sections->debugAbbrev     },
+        { ".debug_str_offsets", &sections->debugStrOffsets },
+    };
+    for (Elf64_Half i = 0; i < header->e_shnum; ++i) {
+        const Elf64_Shdr* current = &sectionHeaders[i];
+        if (current->sh_type == SHT_NOBITS || current->sh_offset + current->sh_size > size) continue;
+
+        for (size_t j = 0; j < sizeof(wanted) / sizeof(*wanted); ++j) {
+            if (strcmp(names + current->sh_name, wanted[j].name) == 0) {
+                *wanted[j].section = (struct lcs_section) { file + current->sh_offset, current->sh_size };
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Counts the emitted line table rows.
+ *
+ * @param rows the emitted rows
+ * @param count the count of the emitted rows
+ * @param args the row counter
+ */
+static void countRows(const struct dwarf_lineInfo* rows, const size_t count, void* args) {
+    (void) rows;
+
+    *(size_t*) args += count;
+}
+
+/**
+ * Decodes all line programs of the given sections once.
+ *
+ * @param sections the sections
+ * @param fileName the name of the decoded file
+ * @return the count of the decoded rows
+ */
+static size_t decode(const struct sections* sections, const char* fileName) {
+    size_t rows = 0;
+    dwarf_parseLineProgram(sections->debugLine, sections->debugLineStr, sections->debugStr, sections->debugInfo,
+                           sections->debugAbbrev, sections->debugStrOffsets, fileName, countRows, &rows);
+    return rows;
+}
+
+int main(const int argc, const char* argv[]) {
+    const char* fileName = argc > 1 ? argv[1] : "/proc/self/exe";
+    const int fd = open(fileName, O_RDONLY);
+    struct stat info;
+    if (fd < 0 || fstat(fd, &info) != 0) {
+        perror(fileName);
+        return 1;
+    }
+    const uint8_t* file = mmap(NULL, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    struct sections sections = { 0 };
+    if (file == MAP_FAILED || !findSections(file, (size_t) info.st_size, &sections)) {
+        printf("%s: Not a mapped 64 bit ELF file\n", fileName);
+        return 1;
+    }
+    if (sections.debugLine.size == 0) {
+        printf("%s: No .debug_line section, nothing to measure\n", fileName);
+        return 0;
+    }
+
+    const size_t rows = decode(&sections, fileName);
+    if (rows == 0) {
+        printf("%s: No line table rows decoded\n", fileName);
+        return 1;
+    }
+    size_t rounds = 0;
+    double seconds;
+    struct timespec begin, end;
+    clock_gettime(CLOCK_MONOTONIC, &begin);
+    do {
+        if (decode(&sections, fileName) != rows) {
+            printf("%s: Differing row counts\n", fileName);
+            return 1;
+        }
+        ++rounds;
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        seconds = (double) (end.tv_sec - begin.tv_sec) + (double) (end.tv_nsec - begin.tv_nsec) / 1e9;
+    } while (seconds < MINIMUM_TIME);
+    munmap((void*) file, (size_t) info.st_size);
+
+    printf("Line programs: %zu rows of %zu bytes, %.1f Mrows/s\n", rows, (size_t) sections.debugLine.size,
+           (double) (rows * rounds) / seconds / 1e6);
+    return 0;
+}
@@ -0,0 +1,171 @@
+/*
+ * CallstackLibrary - Library creating human-readable call stacks.
+ *
+ * Copyright (C) 2026  mhahnFr
+ *
+ * This file is part of the CallstackLibrary.
+ *
+ * The CallstackLibrary is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The CallstackLibrary is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with the
+ * CallstackLibrary, see the file LICENSE.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Translates the callstacks of many threads at once, checking the executable
+ * is only loaded for parsing once per round. Afterwards, the throughput of the
+ * translation is measured for a growing count of threads, starting with cold
+ * caches each time. Linked with the loader wrapped:
+ * -Wl,--wrap=loader_loadFileAndExecuteTime
+ */
+
+#include <limits.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <callstack.h>
+#include <callstack_internals.h>
+
+#include "parser/file/loader.h"
+
+/** The count of the translating threads. */
+#define THREADS 8
+/** The count of the rounds.              */
+#define ROUNDS  20
+/** The translations per measuring thread. */
+#define TRANSLATIONS 2000
+
+/** The file name of the executable.                     */
+static char executable[PATH_MAX];
+/** The count of times the executable has been loaded.   */
+static _Atomic size_t loads = 0;
+/** The count of failed translations.                    */
+static _Atomic size_t fails = 0;
+/** Lets the threads of a round start at the same time.  */
+static pthread_barrier_t barrier;
+
+void __real_loader_loadFileAndExecuteTime(const char* fileName, const time_t* lastModified,
+                                          union loader_parserFunction func, bool extended, void* args);
+
+void __wrap_loader_loadFileAndExecuteTime(const char* fileName, const time_t* lastModified,
+                                          const union loader_parserFunction func, const bool extended,
+                                          void* args) {
+    if (fileName != NULL && strcmp(fileName, executable) == 0) {
+        atomic_fetch_add(&loads, 1);
+    }
+    __real_loader_loadFileAndExecuteTime(fileName, lastModified, func, extended, args);
+}
+
+/**
+ * Creates and translates a callstack of the calling thread.
+ *
+ * @param arg unused
+ * @return @c NULL
+ */
+__attribute__((noinline))
+static void* translate(void* arg) {
+    (void) arg;
+
+    struct callstack* callstack = callstack_new();
+    pthread_barrier_wait(&barrier);
+    struct callstack_frame* frames = callstack_toArray(callstack);
+    if (frames == NULL || callstack_getFrameCount(callstack) == 0
+        || frames[0].function == NULL || strstr(frames[0].function, "translate") == NULL) {
+        atomic_fetch_add(&fails, 1);
+    }
+    callstack_delete(callstack);
+    return NULL;
+}
+
+/**
+ * Translates a callstack of the calling thread repeatedly.
+ *
+ * @param arg unused
+ * @return @c NULL
+ */
+static void* translateRepeatedly(void* arg) {
+    (void) arg;
+
+    for (size_t i = 0; i < TRANSLATIONS; ++i) {
+        struct callstack* callstack = callstack_new();
+        if (callstack_toArray(callstack) == NULL) {
+            atomic_fetch_add(&fails, 1);
+        }
+        callstack_delete(callstack);
+    }
+    return NULL;
+}
+
+/**
+ * Measures the throughput of the translation with the given count of threads.
+ *
+ * @param count the count of the translating threads
+ * @return the translated callstacks per second
+ */
+static double measure(const size_t count) {
+    callstack_clearCaches();
+
+    struct timespec begin, end;
+    clock_gettime(CLOCK_MONOTONIC, &begin);
+    pthread_t threads[THREADS];
+    for (size_t i = 0; i < count; ++i) {
+        pthread_create(&threads[i], NULL, translateRepeatedly, NULL);
+    }
+    for (size_t i = 0; i < count; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    const double seconds = (double) (end.tv_sec - begin.tv_sec) + (double) (end.tv_nsec - begin.tv_nsec) / 1e9;
+    return (double) (count * TRANSLATIONS) / seconds;
+}
+
+int main(void) {
+    const ssize_t length = readlink("/proc/self/exe", executable, sizeof(executable) - 1);
+    if (length < 0) {
+        perror("readlink");
+        return 1;
+    }
+    executable[length] = '\0';
+    callstack_autoClearCaches = false;
+    pthread_barrier_init(&barrier, NULL, THREADS);
+
+    size_t duplicates = 0;
+    for (size_t round = 0; round < ROUNDS; ++round) {
+        atomic_store(&loads, 0);
+        pthread_t threads[THREADS];
+        for (size_t i = 0; i < THREADS; ++i) {
+            pthread_create(&threads[i], NULL, translate, NULL);
+        }
+        for (size_t i = 0; i < THREADS; ++i) {
+            pthread_join(threads[i], NULL);
+        }
+        if (atomic_load(&loads) != 1) {
+            printf("Round %zu: executable loaded %zu times\n", round, atomic_load(&loads));
+            ++duplicates;
+        }
+        callstack_clearCaches();
+    }
+    pthread_barrier_destroy(&barrier);
+
+    printf("Translation throughput with %ld CPUs:\n", sysconf(_SC_NPROCESSORS_ONLN));
+    const double single = measure(1);
+    printf("  1 thread:  %9.0f callstacks/s\n", single);
+    for (size_t count = 2; count <= THREADS; count *= 2) {
+        const double throughput = measure(count);
+        printf("%3zu threads: %9.0f callstacks/s, %.2fx\n", count, throughput, throughput / single);
+    }
+    printf("Parse once: %zu duplicate rounds, %zu failed translations\n", duplicates, atomic_load(&fails));
+    return duplicates != 0 || atomic_load(&fails) != 0;
+}
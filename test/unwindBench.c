@@ -0,0 +1,126 @@
+/*
+ * CallstackLibrary - Library creating human-readable call stacks.
+ *
+ * Copyright (C) 2026  mhahnFr
+ *
+ * This file is part of the CallstackLibrary.
+ *
+ * The CallstackLibrary is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The CallstackLibrary is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with the
+ * CallstackLibrary, see the file LICENSE.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+/*
+ * Measures the time needed for capturing a backtrace with each unwinder at
+ * different depths of the stack.
+ */
+
+#include <stdio.h>
+#include <time.h>
+
+#include <callstack_internals.h>
+
+#include "callstackInternal.h"
+
+/** The count of captures per unwinder and depth. */
+#define CAPTURES 2000
+/** The size of the capture buffer, leaving room for the frames of the library. */
+#define BUFFER_SIZE (2 * CALLSTACK_BACKTRACE_SIZE)
+
+/** The count of failed checks. */
+static size_t fails = 0;
+
+/** The measured unwinders. */
+static const struct {
+    /** The name of the unwinder. */
+    const char* name;
+    /** The unwinder type.        */
+    enum callstack_unwinderType type;
+} unwinders[] = {
+    { "execinfo", CALLSTACK_UNWINDER_EXECINFO      },
+    { "fp walk",  CALLSTACK_UNWINDER_FRAME_POINTER },
+    { "cfi",      CALLSTACK_UNWINDER_CFI           },
+};
+
+/**
+ * Captures the backtrace of the calling function.
+ *
+ * @param buffer the buffer to be filled
+ * @return the count of captured frames
+ */
+__attribute__((noinline))
+static int capture(void* buffer[BUFFER_SIZE]) {
+    return callstack_backtrace(buffer, BUFFER_SIZE, __builtin_return_address(0));
+}
+
+/**
+ * Measures the captures with each unwinder at the current depth.
+ *
+ * @param depth the depth of the stack
+ */
+__attribute__((noinline))
+static void measure(const int depth) {
+    const size_t previousFails = fails;
+    printf("%5d", depth);
+    for (size_t i = 0; i < sizeof(unwinders) / sizeof(*unwinders); ++i) {
+        callstack_unwinder = unwinders[i].type;
+
+        void* buffer[BUFFER_SIZE];
+        struct timespec begin, end;
+        int frames = 0;
+        clock_gettime(CLOCK_MONOTONIC, &begin);
+        for (size_t j = 0; j < CAPTURES; ++j) {
+            frames = capture(buffer);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        if (frames < depth) {
+            ++fails;
+        }
+        const double nanos = (double) (end.tv_sec - begin.tv_sec) * 1e9 + (double) (end.tv_nsec - begin.tv_nsec);
+        printf(" %9.0f", nanos / CAPTURES);
+    }
+    printf(fails == previousFails ? "\n" : "  (stack not fully unwound)\n");
+}
+
+/**
+ * Descends to the given depth of the stack and measures the captures there.
+ *
+ * @param depth the remaining depth
+ * @param total the depth to be measured at
+ * @return the depth measured at
+ */
+__attribute__((noinline))
+static int descend(const int depth, const int total) {
+    if (depth <= 1) {
+        measure(total);
+        return total;
+    }
+    const int result = descend(depth - 1, total);
+    __asm__ volatile("" ::: "memory");
+    return result;
+}
+
+int main(void) {
+    printf("Capture time in ns per backtrace:\n");
+    printf("depth");
+    for (size_t i = 0; i < sizeof(unwinders) / sizeof(*unwinders); ++i) {
+        printf(" %9s", unwinders[i].name);
+    }
+    printf("\n");
+    // The frames of main and of the measuring function count towards the depth.
+    for (int depth = 8; depth <= 128; depth *= 2) {
+        descend(depth - 2, depth);
+    }
+    printf("Unwinders: %zu failures\n", fails);
+    return fails != 0;
+}